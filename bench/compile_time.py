@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+
+# cpp-flexargs
+#
+# Copyright iorate 2018.
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE_1_0.txt or copy at
+# http://www.boost.org/LICENSE_1_0.txt)
+
+# Measures how the compile time of flexargs::match() scales with the number of
+# parameters and arguments.
+#
+# For every (compiler, scenario, size, phase) a translation unit is generated
+# and compiled with -O0. The wall time and the peak RSS of the compiler are
+# written to a CSV file, together with the statistics of template
+# instantiation reported by the compiler in a separate, untimed compilation:
+# the time and the memory spent in template instantiation from g++
+# -ftime-report, and the number of class and function templates of flexargs
+# instantiated from clang++ -ftime-trace.
+#
+# Phases are cumulative: "split" stops after splitting parameters and
+# arguments, "validate" also validates them, "match" also computes the
+# matching, and "construct" is a complete call of match(). The cost of a phase
+# is the difference between it and the previous one.
+
+import argparse
+import csv
+import json
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SCENARIOS = ['positional', 'keyword', 'reversed', 'shuffled', 'defaults']
+PHASES = ['split', 'validate', 'match', 'construct']
+
+PHASE_BODIES = {
+    'split': '''
+    return flexargs::detail::split_params_and_args<{param_types}, Args...>();
+''',
+    'validate': '''
+    using split_t = flexargs::detail::split_params_and_args<{param_types}, Args...>;
+    return std::make_tuple(flexargs::detail::validate_params(typename split_t::params_t()), flexargs::detail::validate_args(typename split_t::args_t()));
+''',
+    'match': '''
+    using split_t = flexargs::detail::split_params_and_args<{param_types}, Args...>;
+    return std::make_tuple(flexargs::detail::validate_params(typename split_t::params_t()), flexargs::detail::validate_args(typename split_t::args_t()), flexargs::detail::match_params_and_args(typename split_t::params_t(), typename split_t::args_t()));
+''',
+    'construct': '''
+    return flexargs::match({params}, std::forward<Args>(args)...);
+''',
+}
+
+
+def generate(scenario, size, phase):
+    # 'defaults' declares every parameter with a default value and passes
+    # every other parameter by keyword. The others declare parameters without
+    # default values and pass all of them.
+    if scenario == 'defaults':
+        params = ['flexargs::parameter<int>(k{0}) = {0}'.format(i) for i in range(size)]
+        args = ['k{0} = {0}'.format(i) for i in range(0, size, 2)]
+    else:
+        params = ['flexargs::parameter<int>(k{0})'.format(i) for i in range(size)]
+        if scenario == 'positional':
+            args = [str(i) for i in range(size)]
+        elif scenario == 'keyword':
+            args = ['k{0} = {0}'.format(i) for i in range(size)]
+        elif scenario == 'reversed':
+            args = ['k{0} = {0}'.format(i) for i in reversed(range(size))]
+        else:
+            # The same order for every run, so that the keyword lookup cannot depend on the order.
+            order = list(range(size))
+            random.Random(size).shuffle(order)
+            args = ['k{0} = {0}'.format(i) for i in order]
+    keywords = ''.join('inline constexpr flexargs::keyword<struct k{0}_> k{0};\n'.format(i) for i in range(size))
+    return '''#include <tuple>
+#include <utility>
+#include "flexargs.hpp"
+
+{keywords}
+template <class ...Args>
+auto f([[maybe_unused]] Args &&...args) {{{body}}}
+
+void call() {{
+    auto r = f({args});
+    static_cast<void>(r);
+}}
+'''.format(
+        keywords=keywords,
+        body=PHASE_BODIES[phase].format(params=', '.join(params), param_types=', '.join('decltype({})'.format(p) for p in params)),
+        args=', '.join(args),
+    )
+
+
+def is_clang(compiler):
+    out = subprocess.run([compiler, '--version'], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, universal_newlines=True).stdout
+    return 'clang' in out
+
+
+def parse_gcc_memory(text):
+    # -ftime-report prints memory in bytes or with a suffix, e.g. '512k' or '17M'.
+    scale = {'k': 1, 'M': 1024, 'G': 1024 * 1024}
+    if text[-1:] in scale:
+        return int(float(text[:-1]) * scale[text[-1]])
+    return int(text) // 1024
+
+
+def instantiation_stats(compiler, flags, source, obj):
+    stats = {'instantiations': '', 'instantiation_s': '', 'instantiation_mem_kb': ''}
+    if is_clang(compiler):
+        # The trace is written next to the object file, and records every instantiation with granularity 0.
+        trace = os.path.splitext(obj)[0] + '.json'
+        proc = subprocess.run([compiler, '-std=c++17', '-O0', '-I', ROOT] + flags + ['-ftime-trace', '-ftime-trace-granularity=0', '-c', source, '-o', obj], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        if proc.returncode == 0 and os.path.exists(trace):
+            with open(trace) as f:
+                events = json.load(f)['traceEvents']
+            stats['instantiations'] = sum(1 for e in events if e.get('name') in ('InstantiateClass', 'InstantiateFunction') and 'flexargs::' in e.get('args', {}).get('detail', ''))
+    else:
+        proc = subprocess.run([compiler, '-std=c++17', '-O0', '-I', ROOT] + flags + ['-ftime-report', '-c', source, '-o', obj], stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+        for line in proc.stderr.splitlines():
+            # ' template instantiation : usr ( %) sys ( %) wall ( %) mem ( %)'
+            if line.strip().startswith('template instantiation') and ':' in line:
+                fields = line.split(':', 1)[1].replace('(', ' ').replace(')', ' ').split()
+                stats['instantiation_s'] = fields[4]
+                stats['instantiation_mem_kb'] = parse_gcc_memory(fields[6])
+    return stats
+
+
+def compile_once(compiler, flags, source, obj):
+    with tempfile.TemporaryFile() as err:
+        start = time.perf_counter()
+        proc = subprocess.Popen([compiler, '-std=c++17', '-O0', '-I', ROOT] + flags + ['-c', source, '-o', obj], stdout=subprocess.DEVNULL, stderr=err)
+        _, status, usage = os.wait4(proc.pid, 0)
+        wall = time.perf_counter() - start
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        err.seek(0)
+        stderr = err.read().decode(errors='replace')
+    # ru_maxrss is in kilobytes on Linux and in bytes on macOS.
+    rss_kb = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+    return proc.returncode, wall, rss_kb, stderr
+
+
+def plot(rows, path):
+    try:
+        import matplotlib
+        matplotlib.use('Agg')
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print('matplotlib is not available; skipped {}'.format(path), file=sys.stderr)
+        return
+    keys = sorted({(r['compiler'], r['scenario']) for r in rows})
+    fig, axes = plt.subplots(len(keys), 1, figsize=(8, 4 * len(keys)), squeeze=False)
+    for ax, (compiler, scenario) in zip(axes[:, 0], keys):
+        for phase in PHASES:
+            points = [(r['size'], r['wall_s']) for r in rows if (r['compiler'], r['scenario'], r['phase']) == (compiler, scenario, phase) and r['status'] == 'ok']
+            if points:
+                ax.plot(*zip(*sorted(points)), marker='o', label=phase)
+        ax.set_title('{} / {}'.format(compiler, scenario))
+        ax.set_xscale('log', base=2)
+        ax.set_xlabel('parameters')
+        ax.set_ylabel('wall time [s]')
+        ax.legend()
+    fig.tight_layout()
+    fig.savefig(path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile-time scaling benchmark of flexargs::match().')
+    parser.add_argument('--compilers', nargs='+', default=['g++', 'clang++'])
+    parser.add_argument('--sizes', nargs='+', type=int, default=[1, 2, 4, 8, 16, 32, 64, 128])
+    parser.add_argument('--scenarios', nargs='+', choices=SCENARIOS, default=SCENARIOS)
+    parser.add_argument('--phases', nargs='+', choices=PHASES, default=PHASES)
+    parser.add_argument('--repeat', type=int, default=1, help='take the best of REPEAT runs')
+    parser.add_argument('--cxxflags', default='', help='extra compiler flags')
+    parser.add_argument('--csv', default='compile_time.csv')
+    parser.add_argument('--plot', help='write a plot of wall times (requires matplotlib)')
+    parser.add_argument('--keep', help='keep generated sources in this directory')
+    opts = parser.parse_args()
+
+    compilers = [c for c in opts.compilers if shutil.which(c)]
+    for c in set(opts.compilers) - set(compilers):
+        print('{} not found; skipped'.format(c), file=sys.stderr)
+    workdir = opts.keep or tempfile.mkdtemp(prefix='flexargs-bench-')
+    os.makedirs(workdir, exist_ok=True)
+
+    rows = []
+    with open(opts.csv, 'w', newline='') as f:
+        writer = csv.DictWriter(f, ['compiler', 'scenario', 'size', 'phase', 'status', 'wall_s', 'peak_rss_kb', 'instantiation_s', 'instantiation_mem_kb', 'instantiations'])
+        writer.writeheader()
+        for compiler in compilers:
+            for scenario in opts.scenarios:
+                for size in opts.sizes:
+                    for phase in opts.phases:
+                        name = '{}_{}_{}'.format(scenario, size, phase)
+                        source = os.path.join(workdir, name + '.cpp')
+                        obj = os.path.join(workdir, name + '.o')
+                        with open(source, 'w') as src:
+                            src.write(generate(scenario, size, phase))
+                        best = None
+                        for _ in range(opts.repeat):
+                            rc, wall, rss, stderr = compile_once(compiler, opts.cxxflags.split(), source, obj)
+                            if rc != 0:
+                                best = None
+                                break
+                            if best is None or wall < best[0]:
+                                best = (wall, rss)
+                        row = {'compiler': compiler, 'scenario': scenario, 'size': size, 'phase': phase}
+                        if best is None:
+                            row.update(status='error', wall_s='', peak_rss_kb='', instantiation_s='', instantiation_mem_kb='', instantiations='')
+                            first = [line for line in stderr.splitlines() if 'error' in line][:1]
+                            print('{} {}: compilation failed{}'.format(compiler, name, ': ' + first[0] if first else ''), file=sys.stderr)
+                        else:
+                            row.update(status='ok', wall_s='{:.3f}'.format(best[0]), peak_rss_kb=best[1])
+                            row.update(instantiation_stats(compiler, opts.cxxflags.split(), source, obj))
+                        writer.writerow(row)
+                        f.flush()
+                        print(','.join(str(row[k]) for k in writer.fieldnames))
+                        row['wall_s'] = float(row['wall_s']) if row['wall_s'] else None
+                        rows.append(row)
+
+    if opts.plot:
+        plot(rows, opts.plot)
+    if not opts.keep:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+
+if __name__ == '__main__':
+    main()
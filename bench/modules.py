@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+
+# cpp-flexargs
+#
+# Copyright iorate 2018.
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE_1_0.txt or copy at
+# http://www.boost.org/LICENSE_1_0.txt)
+
+# Compares the build time of a synthetic multi-TU project using flexargs.hpp
+# with that of the same project importing the module flexargs.
+#
+# Each TU defines a function accepting keyword arguments and calls it in
+# several ways. The project is built from scratch ("clean", including the
+# module interface unit) and then rebuilt after one TU is modified
+# ("incremental", i.e. the TU is compiled and the program is relinked). The
+# wall times are written to a CSV file.
+
+import argparse
+import concurrent.futures
+import csv
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+MODES = ['header', 'module']
+
+TU = '''{prelude}
+
+namespace tu{index} {{
+    inline constexpr flexargs::keyword<struct a_> a;
+    inline constexpr flexargs::keyword<struct b_> b;
+    inline constexpr flexargs::keyword<struct c_> c;
+    inline constexpr flexargs::keyword<struct d_> d;
+
+    template <class ...Args>
+    int calc(Args &&...args) {{
+        auto [a_, b_, c_, d_] = flexargs::match(
+            flexargs::parameter<int>(a),
+            flexargs::parameter<int>(b) = 1,
+            flexargs::keyword_parameter<int>(c) = 2,
+            flexargs::keyword_parameter<int>(d) = {revision},
+            static_cast<Args &&>(args)...
+        );
+        return a_ * b_ + c_ - d_;
+    }}
+}}
+
+int f{index}(int x) {{
+    using namespace tu{index};
+    return calc(x) + calc(b = x, a = 1) + calc(x, d = 4, c = 5) + calc(c = x, a = x, b = x);
+}}
+'''
+
+
+def preludes(mode):
+    return '#include "flexargs.hpp"' if mode == 'header' else 'import flexargs;'
+
+
+def write_project(workdir, mode, tus):
+    sources = []
+    for i in range(tus):
+        path = os.path.join(workdir, 'tu{}.cpp'.format(i))
+        with open(path, 'w') as f:
+            f.write(TU.format(prelude=preludes(mode), index=i, revision=3))
+        sources.append(path)
+    main = os.path.join(workdir, 'main.cpp')
+    with open(main, 'w') as f:
+        f.write(''.join('int f{}(int);\n'.format(i) for i in range(tus)))
+        f.write('int main(int argc, char **) {\n    int r = 0;\n')
+        f.write(''.join('    r += f{}(argc);\n'.format(i) for i in range(tus)))
+        f.write('    return r & 1;\n}\n')
+    return sources + [main]
+
+
+class Toolchain:
+    # Knows how to build the module interface unit and TUs importing it.
+    def __init__(self, compiler, std, flags):
+        self.compiler = compiler
+        self.std = std
+        self.flags = flags
+        self.is_clang = 'clang' in os.path.basename(compiler)
+
+    def base(self, mode):
+        cmd = [self.compiler, '-std=' + self.std, '-I', ROOT] + self.flags
+        if mode == 'module':
+            cmd += ['-fprebuilt-module-path=.'] if self.is_clang else ['-fmodules-ts']
+        return cmd
+
+    def module_commands(self):
+        cppm = os.path.join(ROOT, 'flexargs.cppm')
+        if self.is_clang:
+            return [
+                self.base('module') + ['--precompile', '-x', 'c++-module', cppm, '-o', 'flexargs.pcm'],
+                self.base('module') + ['-c', 'flexargs.pcm', '-o', 'flexargs.o'],
+            ]
+        return [self.base('module') + ['-x', 'c++', '-c', cppm, '-o', 'flexargs.o']]
+
+    def compile_command(self, mode, source):
+        return self.base(mode) + ['-c', source, '-o', os.path.splitext(source)[0] + '.o']
+
+    def link_command(self, objects, exe):
+        return [self.compiler] + objects + ['-o', exe]
+
+
+def run(cmd, cwd):
+    proc = subprocess.run(cmd, cwd=cwd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+    if proc.returncode != 0:
+        first = [line for line in proc.stderr.splitlines() if 'error' in line][:1]
+        raise RuntimeError('{}{}'.format(' '.join(cmd[:1] + cmd[-3:]), ': ' + first[0] if first else ''))
+
+
+def build(toolchain, mode, workdir, sources, jobs):
+    objects = [os.path.splitext(s)[0] + '.o' for s in sources]
+    start = time.perf_counter()
+    if mode == 'module':
+        for cmd in toolchain.module_commands():
+            run(cmd, workdir)
+        objects.append(os.path.join(workdir, 'flexargs.o'))
+    with concurrent.futures.ThreadPoolExecutor(jobs) as pool:
+        for future in [pool.submit(run, toolchain.compile_command(mode, s), workdir) for s in sources]:
+            future.result()
+    run(toolchain.link_command(objects, 'project'), workdir)
+    return time.perf_counter() - start, objects
+
+
+def rebuild_one(toolchain, mode, workdir, source, objects):
+    with open(source) as f:
+        text = f.read()
+    with open(source, 'w') as f:
+        f.write(text.replace('= 3,', '= 4,'))
+    start = time.perf_counter()
+    run(toolchain.compile_command(mode, source), workdir)
+    run(toolchain.link_command(objects, 'project'), workdir)
+    return time.perf_counter() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build-time comparison of flexargs.hpp and the module flexargs.')
+    parser.add_argument('--compilers', nargs='+', default=['g++', 'clang++'])
+    parser.add_argument('--tus', nargs='+', type=int, default=[16, 64, 256])
+    parser.add_argument('--modes', nargs='+', choices=MODES, default=MODES)
+    parser.add_argument('--std', default='c++20')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count() or 1)
+    parser.add_argument('--cxxflags', default='', help='extra compiler flags')
+    parser.add_argument('--csv', default='modules.csv')
+    opts = parser.parse_args()
+
+    with open(opts.csv, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['compiler', 'mode', 'tus', 'status', 'clean_s', 'incremental_s'])
+        for compiler in opts.compilers:
+            if shutil.which(compiler) is None:
+                print('{} not found; skipped'.format(compiler), file=sys.stderr)
+                continue
+            toolchain = Toolchain(compiler, opts.std, opts.cxxflags.split())
+            for tus in opts.tus:
+                for mode in opts.modes:
+                    workdir = tempfile.mkdtemp(prefix='flexargs-bench-')
+                    sources = write_project(workdir, mode, tus)
+                    try:
+                        clean, objects = build(toolchain, mode, workdir, sources, opts.jobs)
+                        incremental = rebuild_one(toolchain, mode, workdir, sources[0], objects)
+                        row = [compiler, mode, tus, 'ok', '{:.3f}'.format(clean), '{:.3f}'.format(incremental)]
+                    except RuntimeError as e:
+                        print('{} {} {}: build failed: {}'.format(compiler, mode, tus, e), file=sys.stderr)
+                        row = [compiler, mode, tus, 'error', '', '']
+                    writer.writerow(row)
+                    f.flush()
+                    print(','.join(str(x) for x in row))
+                    shutil.rmtree(workdir, ignore_errors=True)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,465 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the per-call cost of functions accepting keyword arguments.
+//
+// Each workload is implemented as a plain function (the baseline), a function
+// using flexargs, a function using Boost.Parameter (if available) and a
+// function taking a struct initialized by designated initializers (C++20).
+// All implementations share the same body and are not inlined into the loop,
+// and their inputs and results pass through opaque barriers so that the
+// optimizer cannot fold the calls away.
+//
+// The stride workload takes a width known only at runtime among a few values.
+// Its baseline specializes the body by a switch written by hand, and flexargs
+// dispatches it by dispatch_invoke() and among<>(), or passes it as a runtime
+// value without specialization (flexargs_runtime).
+//
+// Built with FLEXARGS_BENCH_HOLD_BY_REFERENCE, the small trivially copyable
+// arguments are held by reference instead of by value (see
+// flexargs::hold_by_value), and flexargs is reported as flexargs_by_ref.
+//
+// Output: workload,implementation,ns_per_call,relative_to_plain
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../flexargs.hpp"
+
+#if defined(__has_include)
+#if __has_include(<boost/parameter.hpp>) && !defined(FLEXARGS_BENCH_NO_BOOST_PARAMETER)
+#define FLEXARGS_BENCH_BOOST_PARAMETER
+#include <boost/parameter.hpp>
+#endif
+#endif
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#define FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+#endif
+
+#if defined(__GNUC__)
+#define FLEXARGS_BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define FLEXARGS_BENCH_NOINLINE __declspec(noinline)
+#else
+#define FLEXARGS_BENCH_NOINLINE
+#endif
+
+#ifdef FLEXARGS_BENCH_HOLD_BY_REFERENCE
+template <>
+struct flexargs::hold_by_value<int> : std::false_type {};
+
+template <>
+struct flexargs::hold_by_value<std::size_t> : std::false_type {};
+
+template <>
+struct flexargs::hold_by_value<std::string_view> : std::false_type {};
+
+inline constexpr char const *flexargs_name = "flexargs_by_ref";
+#else
+inline constexpr char const *flexargs_name = "flexargs";
+#endif
+
+/* Optimization barriers */
+
+// Makes the optimizer forget what it knows about the value.
+template <class T>
+inline T opaque(T val) {
+#if defined(__GNUC__)
+    asm volatile("" : "+m"(val));
+#else
+    static_cast<void>(const_cast<T volatile &>(val));
+#endif
+    return val;
+}
+
+// Makes the optimizer assume that the value is read.
+template <class T>
+inline void sink(T const &val) {
+#if defined(__GNUC__)
+    asm volatile("" : : "m"(val) : "memory");
+#else
+    static_cast<void>(*static_cast<T const volatile *>(&val));
+#endif
+}
+
+namespace keywords {
+    inline constexpr flexargs::keyword<struct op_> op;
+    inline constexpr flexargs::keyword<struct lhs_> lhs;
+    inline constexpr flexargs::keyword<struct rhs_> rhs;
+    inline constexpr flexargs::keyword<struct text_> text;
+    inline constexpr flexargs::keyword<struct prefix_> prefix;
+    inline constexpr flexargs::keyword<struct width_> width;
+    inline constexpr flexargs::keyword<struct values_> values;
+    inline constexpr flexargs::keyword<struct first_> first;
+    inline constexpr flexargs::keyword<struct last_> last;
+    inline constexpr flexargs::keyword<struct out_> out;
+    inline constexpr flexargs::keyword<struct in_> in;
+    inline constexpr flexargs::keyword<struct factor_> factor;
+    inline constexpr flexargs::keyword<struct stride_> stride;
+}
+
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+namespace bp {
+    BOOST_PARAMETER_NAME(op)
+    BOOST_PARAMETER_NAME(lhs)
+    BOOST_PARAMETER_NAME(rhs)
+    BOOST_PARAMETER_NAME(text)
+    BOOST_PARAMETER_NAME(prefix)
+    BOOST_PARAMETER_NAME(width)
+    BOOST_PARAMETER_NAME(values)
+    BOOST_PARAMETER_NAME(first)
+    BOOST_PARAMETER_NAME(last)
+    BOOST_PARAMETER_NAME(out)
+    BOOST_PARAMETER_NAME(in)
+    BOOST_PARAMETER_NAME(factor)
+}
+#endif
+
+/* calc: a string_view and two ints with default values */
+
+inline int calc_body(std::string_view op, int lhs, int rhs) {
+    if (op == "add") {
+        return lhs + rhs;
+    } else if (op == "sub") {
+        return lhs - rhs;
+    } else if (op == "mul") {
+        return lhs * rhs;
+    } else if (op == "div") {
+        if (rhs == 0) {
+            throw std::invalid_argument("division by zero");
+        } else {
+            return lhs / rhs;
+        }
+    } else {
+        throw std::invalid_argument("bad operator");
+    }
+}
+
+FLEXARGS_BENCH_NOINLINE int calc_plain(std::string_view op, int lhs = 100, int rhs = 200) {
+    return calc_body(op, lhs, rhs);
+}
+
+template <class ...Args>
+FLEXARGS_BENCH_NOINLINE int calc_flexargs(Args &&...args) {
+    auto [op, lhs, rhs] = flexargs::match(
+        flexargs::parameter<std::string_view>(keywords::op),
+        flexargs::parameter<int>(keywords::lhs) = 100,
+        flexargs::parameter<int>(keywords::rhs) = 200,
+        std::forward<Args>(args)...
+    );
+    return calc_body(op, lhs, rhs);
+}
+
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+namespace bp {
+    BOOST_PARAMETER_FUNCTION((int), calc_boost_parameter, tag,
+        (required (op, (std::string_view)))
+        (optional (lhs, (int), 100) (rhs, (int), 200))
+    ) {
+        return calc_body(op, lhs, rhs);
+    }
+}
+#endif
+
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+struct calc_args {
+    std::string_view op;
+    int lhs = 100;
+    int rhs = 200;
+};
+
+FLEXARGS_BENCH_NOINLINE int calc_designated(calc_args const &args) {
+    return calc_body(args.op, args.lhs, args.rhs);
+}
+#endif
+
+/* label: a std::string by value and a string_view with a default value */
+
+inline std::size_t label_body(std::string const &text, std::string_view prefix, std::size_t width) {
+    return std::max(prefix.size() + text.size(), width);
+}
+
+FLEXARGS_BENCH_NOINLINE std::size_t label_plain(std::string text, std::string_view prefix = "", std::size_t width = 0) {
+    return label_body(text, prefix, width);
+}
+
+template <class ...Args>
+FLEXARGS_BENCH_NOINLINE std::size_t label_flexargs(Args &&...args) {
+    auto [text, prefix, width] = flexargs::match(
+        flexargs::parameter<std::string>(keywords::text),
+        flexargs::parameter<std::string_view>(keywords::prefix) = "",
+        flexargs::parameter<std::size_t>(keywords::width) = 0,
+        std::forward<Args>(args)...
+    );
+    return label_body(text, prefix, width);
+}
+
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+namespace bp {
+    BOOST_PARAMETER_FUNCTION((std::size_t), label_boost_parameter, tag,
+        (required (text, (std::string)))
+        (optional (prefix, (std::string_view), std::string_view()) (width, (std::size_t), 0))
+    ) {
+        return label_body(text, prefix, width);
+    }
+}
+#endif
+
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+struct label_args {
+    std::string text;
+    std::string_view prefix = "";
+    std::size_t width = 0;
+};
+
+FLEXARGS_BENCH_NOINLINE std::size_t label_designated(label_args const &args) {
+    return label_body(args.text, args.prefix, args.width);
+}
+#endif
+
+/* sum: a vector by reference and two indices with default values */
+
+inline int sum_body(std::vector<int> const &values, std::size_t first, std::size_t last) {
+    return std::accumulate(values.begin() + first, values.begin() + std::min(last, values.size()), 0);
+}
+
+FLEXARGS_BENCH_NOINLINE int sum_plain(std::vector<int> const &values, std::size_t first = 0, std::size_t last = -1) {
+    return sum_body(values, first, last);
+}
+
+template <class ...Args>
+FLEXARGS_BENCH_NOINLINE int sum_flexargs(Args &&...args) {
+    auto [values, first, last] = flexargs::match(
+        flexargs::parameter<std::vector<int> const &>(keywords::values),
+        flexargs::parameter<std::size_t>(keywords::first) = 0,
+        flexargs::parameter<std::size_t>(keywords::last) = -1,
+        std::forward<Args>(args)...
+    );
+    return sum_body(values, first, last);
+}
+
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+namespace bp {
+    BOOST_PARAMETER_FUNCTION((int), sum_boost_parameter, tag,
+        (required (values, (std::vector<int>)))
+        (optional (first, (std::size_t), 0) (last, (std::size_t), std::size_t(-1)))
+    ) {
+        return sum_body(values, first, last);
+    }
+}
+#endif
+
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+struct sum_args {
+    std::vector<int> const &values;
+    std::size_t first = 0;
+    std::size_t last = -1;
+};
+
+FLEXARGS_BENCH_NOINLINE int sum_designated(sum_args const &args) {
+    return sum_body(args.values, args.first, args.last);
+}
+#endif
+
+/* scale: references only */
+
+inline void scale_body(int &out, int const &in, int factor) {
+    out += in * factor;
+}
+
+FLEXARGS_BENCH_NOINLINE void scale_plain(int &out, int const &in, int factor = 2) {
+    scale_body(out, in, factor);
+}
+
+template <class ...Args>
+FLEXARGS_BENCH_NOINLINE void scale_flexargs(Args &&...args) {
+    auto [out, in, factor] = flexargs::match(
+        flexargs::parameter(keywords::out),
+        flexargs::parameter(keywords::in),
+        flexargs::parameter<int>(keywords::factor) = 2,
+        std::forward<Args>(args)...
+    );
+    scale_body(out, in, factor);
+}
+
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+namespace bp {
+    BOOST_PARAMETER_FUNCTION((void), scale_boost_parameter, tag,
+        (required (in_out(out), *) (in, (int)))
+        (optional (factor, (int), 2))
+    ) {
+        scale_body(out, in, factor);
+    }
+}
+#endif
+
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+struct scale_args {
+    int &out;
+    int const &in;
+    int factor = 2;
+};
+
+FLEXARGS_BENCH_NOINLINE void scale_designated(scale_args const &args) {
+    scale_body(args.out, args.in, args.factor);
+}
+#endif
+
+/* stride: a width among a few values, specialized for each of them */
+
+template <class Stride>
+inline int stride_body(std::vector<int> const &values, Stride stride) {
+    int s = 0;
+    for (std::size_t i = 0; i + stride <= values.size(); i += stride) {
+        for (std::size_t j = 0; j < static_cast<std::size_t>(stride); ++j) {
+            s += values[i + j] * static_cast<int>(j);
+        }
+    }
+    return s;
+}
+
+FLEXARGS_BENCH_NOINLINE int stride_plain(std::vector<int> const &values, int stride) {
+    switch (stride) {
+    case 4:
+        return stride_body(values, std::integral_constant<int, 4>());
+    case 8:
+        return stride_body(values, std::integral_constant<int, 8>());
+    case 16:
+        return stride_body(values, std::integral_constant<int, 16>());
+    default:
+        return stride_body(values, stride);
+    }
+}
+
+template <class ...Args>
+FLEXARGS_BENCH_NOINLINE int stride_flexargs(Args &&...args) {
+    auto [values, stride] = flexargs::match(
+        flexargs::parameter<std::vector<int> const &>(keywords::values),
+        flexargs::parameter<int>(keywords::stride),
+        std::forward<Args>(args)...
+    );
+    return stride_body(values, stride);
+}
+
+inline constexpr auto call_stride_flexargs = [](auto &&...args) { return stride_flexargs(std::forward<decltype(args)>(args)...); };
+
+/* Driver */
+
+long iterations = 10'000'000;
+int repetitions = 5;
+
+template <class F>
+double measure(F f) {
+    double best = -1;
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < iterations; ++i) {
+            f();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        double ns = elapsed.count() / iterations;
+        if (best < 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+struct reporter {
+    char const *workload;
+    double plain = 0;
+
+    template <class F>
+    void operator()(char const *implementation, F f) {
+        double ns = measure(f);
+        if (std::string_view(implementation) == "plain") {
+            plain = ns;
+        }
+        std::printf("%s,%s,%.3f,%.2f\n", workload, implementation, ns, ns / plain);
+        std::fflush(stdout);
+    }
+};
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        iterations = std::atol(argv[1]);
+    }
+    if (argc > 2) {
+        repetitions = std::atoi(argv[2]);
+    }
+
+    using namespace keywords;
+    std::string_view const sub = "sub";
+    std::string const hello = "hello";
+    std::vector<int> const vec(16, 1);
+    int acc = 0;
+
+    std::printf("workload,implementation,ns_per_call,relative_to_plain\n");
+    {
+        reporter report = {"calc"};
+        report("plain", [&] { sink(calc_plain(opaque(sub), opaque(999))); });
+        report(flexargs_name, [&] { sink(calc_flexargs(op = opaque(sub), lhs = opaque(999))); });
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+        report("boost_parameter", [&] { sink(bp::calc_boost_parameter(bp::_op = opaque(sub), bp::_lhs = opaque(999))); });
+#endif
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+        report("designated", [&] { sink(calc_designated({.op = opaque(sub), .lhs = opaque(999)})); });
+#endif
+    }
+    {
+        reporter report = {"label"};
+        report("plain", [&] { sink(label_plain(std::string(opaque(hello.data()), 5), "> ")); });
+        report(flexargs_name, [&] { sink(label_flexargs(text = std::string(opaque(hello.data()), 5), prefix = "> ")); });
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+        report("boost_parameter", [&] { sink(bp::label_boost_parameter(bp::_text = std::string(opaque(hello.data()), 5), bp::_prefix = "> ")); });
+#endif
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+        report("designated", [&] { sink(label_designated({.text = std::string(opaque(hello.data()), 5), .prefix = "> "})); });
+#endif
+    }
+    {
+        reporter report = {"sum"};
+        report("plain", [&] { sink(sum_plain(*opaque(&vec), opaque(std::size_t(4)))); });
+        report(flexargs_name, [&] { sink(sum_flexargs(values = *opaque(&vec), first = opaque(std::size_t(4)))); });
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+        report("boost_parameter", [&] { sink(bp::sum_boost_parameter(bp::_values = *opaque(&vec), bp::_first = opaque(std::size_t(4)))); });
+#endif
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+        report("designated", [&] { sink(sum_designated({.values = *opaque(&vec), .first = opaque(std::size_t(4))})); });
+#endif
+    }
+    {
+        reporter report = {"scale"};
+        int const one = 1;
+        report("plain", [&] { scale_plain(acc, opaque(one), 3); });
+        report(flexargs_name, [&] { scale_flexargs(in = opaque(one), out = acc, factor = 3); });
+#ifdef FLEXARGS_BENCH_BOOST_PARAMETER
+        report("boost_parameter", [&] { bp::scale_boost_parameter(bp::_in = opaque(one), bp::_out = acc, bp::_factor = 3); });
+#endif
+#ifdef FLEXARGS_BENCH_DESIGNATED_INITIALIZERS
+        report("designated", [&] { scale_designated({.out = acc, .in = opaque(one), .factor = 3}); });
+#endif
+        sink(acc);
+    }
+    {
+        reporter report = {"stride"};
+        report("plain", [&] { sink(stride_plain(*opaque(&vec), opaque(8))); });
+        report(flexargs_name, [&] { sink(flexargs::dispatch_invoke(call_stride_flexargs, values = *opaque(&vec), stride = flexargs::among<4, 8, 16>(opaque(8)))); });
+        report("flexargs_runtime", [&] { sink(stride_flexargs(values = *opaque(&vec), stride = opaque(8))); });
+    }
+}
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+
+# cpp-flexargs
+#
+# Copyright iorate 2018.
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE_1_0.txt or copy at
+# http://www.boost.org/LICENSE_1_0.txt)
+
+# Builds bench/runtime.cpp with each compiler and optimization level, runs it,
+# and collects the per-call costs into a CSV file. Each configuration is also
+# built with FLEXARGS_BENCH_HOLD_BY_REFERENCE, from which only the flexargs_by_ref
+# rows are kept, to show the effect of holding small arguments by value.
+
+import argparse
+import csv
+import io
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# The extra flags of each build, and the implementation whose rows are kept (None for all).
+VARIANTS = [([], None), (['-DFLEXARGS_BENCH_HOLD_BY_REFERENCE'], 'flexargs_by_ref')]
+
+
+def build(compiler, std, opt, flags, exe):
+    cmd = [compiler, '-std=' + std, opt] + flags + [os.path.join(HERE, 'runtime.cpp'), '-o', exe]
+    return subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Runtime benchmark of functions accepting keyword arguments.')
+    parser.add_argument('--compilers', nargs='+', default=['g++', 'clang++'])
+    parser.add_argument('--opts', nargs='+', default=['O0', 'Og', 'O2', 'O3'], help='optimization levels without the leading dash')
+    parser.add_argument('--std', default='c++20', help='falls back to c++17 (without designated initializers) if unsupported')
+    parser.add_argument('--iterations', type=int, default=10000000)
+    parser.add_argument('--repetitions', type=int, default=5)
+    parser.add_argument('--cxxflags', default='', help='extra compiler flags')
+    parser.add_argument('--csv', default='runtime.csv')
+    opts = parser.parse_args()
+
+    workdir = tempfile.mkdtemp(prefix='flexargs-bench-')
+    with open(opts.csv, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['compiler', 'opt', 'workload', 'implementation', 'ns_per_call', 'relative_to_plain'])
+        for compiler in opts.compilers:
+            if shutil.which(compiler) is None:
+                print('{} not found; skipped'.format(compiler), file=sys.stderr)
+                continue
+            for opt in opts.opts:
+                opt = opt.lstrip('-')
+                for variant, keep in VARIANTS:
+                    exe = os.path.join(workdir, 'runtime')
+                    flags = variant + opts.cxxflags.split()
+                    proc = build(compiler, opts.std, '-' + opt, flags, exe)
+                    if proc.returncode != 0 and opts.std != 'c++17':
+                        proc = build(compiler, 'c++17', '-' + opt, flags, exe)
+                    if proc.returncode != 0:
+                        print('{} {}: compilation failed\n{}'.format(compiler, opt, proc.stderr), file=sys.stderr)
+                        continue
+                    out = subprocess.run([exe, str(opts.iterations), str(opts.repetitions)], stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+                    for row in csv.DictReader(io.StringIO(out)):
+                        if keep is not None and row['implementation'] != keep:
+                            continue
+                        line = [compiler, '-' + opt, row['workload'], row['implementation'], row['ns_per_call'], row['relative_to_plain']]
+                        writer.writerow(line)
+                        f.flush()
+                        print('{:<10} {:<4} {:<6} {:<16} {:>10} ns {:>7}x'.format(*line))
+    shutil.rmtree(workdir, ignore_errors=True)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,54 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "../flexargs.hpp"
+using namespace flexargs;
+
+namespace keywords {
+    inline constexpr keyword<struct op_> op;
+    inline constexpr keyword<struct lhs_> lhs;
+    inline constexpr keyword<struct rhs_> rhs;
+    inline constexpr keyword<struct out_> out;
+}
+
+template <class ...Args>
+void calc(Args &&...args) {
+    auto [lhs, rhs, out, op] = match(
+        parameter<int>(keywords::lhs),
+        parameter<int>(keywords::rhs),
+        parameter<int &>(keywords::out),
+        parameter<std::string_view>(keywords::op) = "add",
+        std::forward<Args>(args)...
+    );
+    out = op == "sub" ? lhs - rhs : lhs + rhs;
+}
+
+int main() {
+    using namespace keywords;
+    std::vector<int> a = {1, 2, 3, 4}, b = {10, 20, 30, 40}, c(4);
+    batch_invoke(
+        [](auto &&...args) { calc(std::forward<decltype(args)>(args)...); },
+        lhs = column(b), rhs = column(a), out = column(c),  // A column passes one value per row.
+        op = "sub"                                          // A scalar is passed to every row.
+    );
+    for (int i : c) {
+        std::cout << i << " ";
+    }
+    std::cout << "\n";
+}
+
+/*
+$ g++ -std=c++17 batch.cpp -o batch
+
+$ ./batch
+9 18 27 36 
+*/
@@ -0,0 +1,61 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <string_view>
+#include <utility>
+#include "../flexargs_cli.hpp"                    // Include the header file for command lines.
+using namespace flexargs;
+
+namespace keywords {
+    struct op_ { static constexpr std::string_view name = "op"; };
+                                                  // Give a keyword a name.
+    struct lhs_ { static constexpr std::string_view name = "lhs"; };
+    struct rhs_ { static constexpr std::string_view name = "rhs"; };
+    inline constexpr keyword<op_> op;
+    inline constexpr keyword<lhs_> lhs;
+    inline constexpr keyword<rhs_> rhs;
+}
+
+template <class ...Args>
+void calc(Args &&...args) {
+    auto [op, lhs, rhs] = match(
+        parameter<std::string_view>(keywords::op),
+        parameter<int>(keywords::lhs),
+        parameter<int>(keywords::rhs) = 1,
+        std::forward<Args>(args)...
+    );
+    std::cout << (op == "sub" ? lhs - rhs : lhs + rhs) << "\n";
+}
+
+int main(int, char **argv) {
+    auto e = bind_cli(
+        argv,
+        [](auto &&...args) { calc(std::forward<decltype(args)>(args)...); },
+        parameter<std::string_view>(keywords::op),
+        parameter<int>(keywords::lhs),
+        parameter<int>(keywords::rhs) = 1
+    );
+    if (e) {
+        std::cerr << "invalid argument: " << e.arg << "\n";
+        return 1;
+    }
+}
+
+/*
+$ g++ -std=c++17 cli.cpp -o cli
+
+$ ./cli add --lhs=999 --rhs 1
+1000
+
+$ ./cli --lhs=3 sub
+2
+
+$ ./cli add --lhs=x
+invalid argument: x
+*/
@@ -0,0 +1,60 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include "../flexargs.hpp"
+using namespace flexargs;
+
+namespace keywords {
+    inline constexpr keyword<struct text_> text;
+    inline constexpr keyword<struct fill_> fill;
+    inline constexpr keyword<struct width_> width;
+}
+
+std::string make_fill() {
+    std::cout << "make_fill() is called\n";
+    return "*";
+}
+
+template <class ...Args>
+void banner(Args &&...args) {
+    auto [text, fill, width] = match(
+        parameter<std::string>(keywords::text),
+        parameter<std::string>(keywords::fill) = lazy(make_fill),    // Computed only when 'fill' is not specified.
+        parameter<std::size_t>(keywords::width) = lazy([](std::string const &text, std::string const &) {
+            return text.size() + 4;                                  // A lazy default value can depend on
+        }),                                                          // the preceding parameters.
+        std::forward<Args>(args)...
+    );
+    std::string line;
+    while (line.size() < width) {
+        line += fill;
+    }
+    std::cout << line << "\n" << text << "\n" << line << "\n";
+}
+
+int main() {
+    using namespace keywords;
+    banner("Hello");
+    banner("World", fill = "-", width = 10);
+}
+
+/*
+$ g++ -std=c++17 lazy_default.cpp -o lazy_default
+
+$ ./lazy_default
+make_fill() is called
+*********
+Hello
+*********
+----------
+World
+----------
+*/
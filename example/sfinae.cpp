@@ -29,7 +29,7 @@ constexpr auto multiply_v1(Args &&...args) {
 
 template <
     class ...Args,
-    class Params = decltype(match_(                    // A result type of 'match_()' is a tuple of parameter types.
+    class Params = decltype(match_(                    // A result type of 'match_()' is a tuple-like type of parameters.
         parameter<std::is_arithmetic>(keywords::lhs),  // You can use it for further validation of parameter types.
         parameter<std::is_arithmetic>(keywords::rhs),
         std::declval<Args>()...
@@ -44,12 +44,24 @@ constexpr auto multiply_v2(Args &&...args) {
     return lhs * rhs;
 }
 
+inline constexpr auto multiply_sig = signature(        // A signature declares parameters once.
+    parameter<std::is_arithmetic>(keywords::lhs),
+    parameter<std::is_arithmetic>(keywords::rhs)
+);
+
+template <class ...Args, class Params = decltype(match_(multiply_sig, std::declval<Args>()...))>
+constexpr auto multiply_v3(Args &&...args) {           // 'match_()' and 'match()' share the matching.
+    auto [lhs, rhs] = match(multiply_sig, std::forward<Args>(args)...);
+    return lhs * rhs;
+}
+
 int main() {
     using namespace keywords;
     static_assert(multiply_v1(lhs = 3, rhs = 4) == 12);
     static_assert(multiply_v1(lhs = 3, rhs = "4") == 12);
     static_assert(multiply_v2(lhs = 3, rhs = 4) == 12);
     static_assert(multiply_v2(lhs = 3, rhs = "4") == 12);
+    static_assert(multiply_v3(lhs = 3, rhs = 4) == 12);
 }
 
 /*
@@ -0,0 +1,59 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include "../flexargs.hpp"
+using namespace flexargs;
+
+namespace keywords {
+    inline constexpr keyword<struct text_> text;
+    inline constexpr keyword<struct fill_> fill;
+    inline constexpr keyword<struct width_> width;
+    inline constexpr keyword<struct words_> words;
+    inline constexpr keyword<struct options_> options;
+}
+
+template <class ...Args>
+void banner(Args &&...args) {
+    auto [text, fill, width] = match(
+        parameter<std::string>(keywords::text),
+        parameter<std::string>(keywords::fill) = "*",
+        parameter<std::size_t>(keywords::width) = 10,
+        std::forward<Args>(args)...
+    );
+    std::string line;
+    while (line.size() < width) {
+        line += fill;
+    }
+    std::cout << line << "\n" << text << "\n" << line << "\n";
+}
+
+template <class ...Args>
+void headline(Args &&...args) {
+    auto [words, options] = match(
+        var_positional(keywords::words),                            // Receives the extra non-keyword arguments.
+        var_keyword(keywords::options),                             // Receives the unknown keyword arguments.
+        std::forward<Args>(args)...
+    );
+    std::string text = std::move(words).apply([](auto const &...words) {
+        std::string s;
+        ((s += s.empty() ? "" : " ", s += words), ...);
+        return s;
+    });
+    std::move(options).apply([&](auto &&...options) {
+        banner(std::move(text), std::forward<decltype(options)>(options)...);  // Passed on as they are.
+    });
+}
+
+int main() {
+    using namespace keywords;
+    headline("Hello,", "World!");
+    headline("Hello,", "World!", fill = "-", width = 16);
+}
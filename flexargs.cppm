@@ -0,0 +1,40 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// The module interface unit of cpp-flexargs for C++20.
+// The standard headers are included in the global module fragment, and flexargs.hpp in the purview, with the namespace flexargs exported.
+
+module;
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#ifdef FLEXARGS_PROFILE
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+#endif
+
+export module flexargs;
+
+#define FLEXARGS_EXPORT export
+#include "flexargs.hpp"
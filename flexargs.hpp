@@ -13,13 +13,114 @@
 #include "cpp-flexargs: the compiler does not support C++17"
 #endif
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
-namespace flexargs {
+// Define FLEXARGS_PROFILE to count the calls of match() per parameter list and matching plan, see profile_records().
+#ifdef FLEXARGS_PROFILE
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+#ifndef FLEXARGS_PROFILE_MAX_PLANS
+#define FLEXARGS_PROFILE_MAX_PLANS 1024
+#endif
+// A call of match() evaluated at compile time is not counted.
+// Without a way to tell it, match() is not usable in constant expressions in this mode.
+#if defined(__cpp_lib_is_constant_evaluated)
+#define FLEXARGS_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define FLEXARGS_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define FLEXARGS_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#ifndef FLEXARGS_IS_CONSTANT_EVALUATED
+#define FLEXARGS_IS_CONSTANT_EVALUATED() false
+#endif
+#endif
+
+// Functions evaluated at runtime are forcibly inlined so that match() is flattened even in debug builds.
+// Define FLEXARGS_NO_FORCE_INLINE to disable it.
+#if defined(FLEXARGS_NO_FORCE_INLINE)
+#define FLEXARGS_INLINE inline
+#elif defined(_MSC_VER) && !defined(__clang__)
+#define FLEXARGS_INLINE __forceinline
+#elif defined(__GNUC__)
+#if defined(__has_attribute)
+#if __has_attribute(artificial)
+#define FLEXARGS_INLINE inline __attribute__((always_inline, artificial))
+#endif
+#endif
+#ifndef FLEXARGS_INLINE
+#define FLEXARGS_INLINE inline __attribute__((always_inline))
+#endif
+#else
+#define FLEXARGS_INLINE inline
+#endif
+
+// Defined as 'export' by the module interface unit flexargs.cppm, which includes this header in its purview.
+#ifndef FLEXARGS_EXPORT
+#define FLEXARGS_EXPORT
+#endif
+
+FLEXARGS_EXPORT namespace flexargs {
+
+#ifdef FLEXARGS_PROFILE
+// The calls of match() with a parameter list and a matching plan, which is determined by the types of the arguments.
+struct profile_record {
+    // The ids of the parameters.
+    std::vector<std::string> parameters;
+    // The ids of the keyword arguments, or empty strings for the non-keyword arguments.
+    std::vector<std::string> arguments;
+    // Whether each parameter takes its default value.
+    std::vector<bool> defaults;
+    std::uint64_t calls;
+    // Whether the plan is beyond FLEXARGS_PROFILE_MAX_PLANS, in which case its calls are counted under a lock instead of in the shards.
+    bool overflowed;
+};
+#endif
+
+// Whether an argument of type T passed as an rvalue is held by value rather than by reference.
+// Small trivially copyable values are held by value, so that they need not be materialized as temporaries and referenced.
+// Specialize this to change the policy for a type.
+template <class T>
+struct hold_by_value : std::bool_constant<std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void *)> {};
+
+// A contiguous sequence of values passed to batch_invoke(), which passes one of them per row.
+template <class T>
+struct column_view {
+    T *data;
+    std::size_t size;
+};
+
+// The value of an optional parameter whose argument is not passed, e.g. 'if constexpr (is_absent_v<decltype(x)>)'.
+struct absent_t {};
+
+inline constexpr absent_t absent = {};
+
+template <class T>
+inline constexpr bool is_absent_v = std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, absent_t>;
+
+// The number of the enumerators of E, which are E(0), ..., E(N - 1), for among_enum<E>().
+// Specialize this for an enumeration type.
+template <class E>
+struct enum_size;
 
 namespace detail {
 
@@ -50,6 +151,12 @@ struct duplicate_argument {};
 template <class Id>
 struct missing_argument {};
 
+template <class Id>
+struct non_keyword_parameter_after_var_positional_parameter {};
+
+template <class Id>
+struct parameter_after_var_keyword_parameter {};
+
 template <class Id>
 struct extra_keyword_argument {};
 
@@ -69,9 +176,18 @@ struct not_movable {};
 template <class T, class Type>
 struct not_convertible {};
 
+template <class Type, class ...Args>
+struct not_constructible {};
+
 template <class T, template <class> class Constraint>
 struct not_satisfying {};
 
+template <class F, class ...Args>
+struct not_invocable {};
+
+template <class T>
+struct not_dispatched {};
+
 template <class T>
 struct is_error : std::false_type {};
 
@@ -95,16 +211,152 @@ struct default_parameter {
 
     using pass_default = typename Pass::template apply_default<Def>;
 
+    template <class ...PrecedingVals>
+    using pass_default_for = pass_default;
+
     static constexpr bool is_keyword = IsKeyword;
     static constexpr bool is_default = true;
+    static constexpr bool takes_preceding = false;
 
     Def &&_def;
 
-    Def &&def() const && {
+    template <class ...PrecedingVals>
+    FLEXARGS_INLINE constexpr Def &&def(PrecedingVals &...) const && {
         return std::forward<Def>(_def);
     }
 };
 
+template <class F>
+struct lazy_default {
+    F &&_f;
+};
+
+template <class Pass, class F, class Args, class = void>
+struct lazy_default_val;
+
+template <class Pass, class F, class ...Args>
+struct lazy_default_val<Pass, F, std::tuple<Args...>, std::enable_if_t<!std::is_invocable_v<F, Args...>>> {
+    using type = type_error<not_invocable<F, Args...>>;
+};
+
+template <class Pass, class F, class ...Args>
+struct lazy_default_val<Pass, F, std::tuple<Args...>, std::enable_if_t<std::is_invocable_v<F, Args...>>> {
+    using type = typename Pass::template apply_default<std::invoke_result_t<F, Args...>>;
+};
+
+// The default value is computed by f() or, if it is not invocable with no arguments, by f(preceding parameters...).
+template <class Id, class Pass, bool IsKeyword, class F>
+struct lazy_default_parameter {
+    using id = Id;
+
+    template <class T>
+    using pass = typename Pass::template apply<T>;
+
+    static constexpr bool is_keyword = IsKeyword;
+    static constexpr bool is_default = true;
+    static constexpr bool takes_preceding = !std::is_invocable_v<F>;
+
+    template <class ...PrecedingVals>
+    using pass_default_for = typename lazy_default_val<
+        Pass,
+        F,
+        std::conditional_t<takes_preceding, std::tuple<std::remove_reference_t<PrecedingVals> &...>, std::tuple<>>
+    >::type;
+
+    using pass_default = pass_default_for<>;
+
+    F &&_f;
+
+    template <class ...PrecedingVals>
+    FLEXARGS_INLINE constexpr decltype(auto) def([[maybe_unused]] PrecedingVals &...preceding_vals) const && {
+        if constexpr (takes_preceding) {
+            return std::forward<F>(_f)(preceding_vals...);
+        } else {
+            return std::forward<F>(_f)();
+        }
+    }
+};
+
+// The parameters of a signature own their default values, which are copied when they are used.
+template <class Id, class Pass, bool IsKeyword, class Def>
+struct owning_default_parameter {
+    using id = Id;
+
+    template <class T>
+    using pass = typename Pass::template apply<T>;
+
+    using pass_default = typename Pass::template apply_default<Def>;
+
+    template <class ...PrecedingVals>
+    using pass_default_for = pass_default;
+
+    static constexpr bool is_keyword = IsKeyword;
+    static constexpr bool is_default = true;
+    static constexpr bool takes_preceding = false;
+
+    Def _def;
+
+    template <class ...PrecedingVals>
+    FLEXARGS_INLINE constexpr Def def(PrecedingVals &...) const && {
+        return _def;
+    }
+};
+
+template <class Id, class Pass, bool IsKeyword, class F>
+struct owning_lazy_default_parameter {
+    using id = Id;
+
+    template <class T>
+    using pass = typename Pass::template apply<T>;
+
+    static constexpr bool is_keyword = IsKeyword;
+    static constexpr bool is_default = true;
+    static constexpr bool takes_preceding = !std::is_invocable_v<F const &>;
+
+    template <class ...PrecedingVals>
+    using pass_default_for = typename lazy_default_val<
+        Pass,
+        F const &,
+        std::conditional_t<takes_preceding, std::tuple<std::remove_reference_t<PrecedingVals> &...>, std::tuple<>>
+    >::type;
+
+    using pass_default = pass_default_for<>;
+
+    F _f;
+
+    template <class ...PrecedingVals>
+    FLEXARGS_INLINE constexpr decltype(auto) def([[maybe_unused]] PrecedingVals &...preceding_vals) const && {
+        if constexpr (takes_preceding) {
+            return _f(preceding_vals...);
+        } else {
+            return _f();
+        }
+    }
+};
+
+// The value is absent_t if the argument is not passed, so that the callee can tell it at compile time.
+template <class Id, class Pass, bool IsKeyword>
+struct optional_parameter {
+    using id = Id;
+
+    template <class T>
+    using pass = typename Pass::template apply<T>;
+
+    using pass_default = absent_t;
+
+    template <class ...PrecedingVals>
+    using pass_default_for = pass_default;
+
+    static constexpr bool is_keyword = IsKeyword;
+    static constexpr bool is_default = true;
+    static constexpr bool takes_preceding = false;
+
+    template <class ...PrecedingVals>
+    FLEXARGS_INLINE constexpr absent_t def(PrecedingVals &...) const && {
+        return {};
+    }
+};
+
 template <class Id, class Pass, bool IsKeyword>
 struct parameter {
     using id = Id;
@@ -116,11 +368,46 @@ struct parameter {
     static constexpr bool is_default = false;
 
     template <class Def>
-    constexpr default_parameter<Id, Pass, IsKeyword, Def> operator=(Def &&def) const {
+    FLEXARGS_INLINE constexpr default_parameter<Id, Pass, IsKeyword, Def> operator=(Def &&def) const {
         return {std::forward<Def>(def)};
     }
+
+    template <class F>
+    FLEXARGS_INLINE constexpr lazy_default_parameter<Id, Pass, IsKeyword, F> operator=(lazy_default<F> &&def) const {
+        return {std::forward<F>(def._f)};
+    }
+};
+
+// A parameter receiving the arguments which no other parameter receives, i.e. the extra non-keyword arguments if !IsKeyword and the unknown keyword arguments if IsKeyword.
+template <class Id, bool IsKeyword>
+struct var_parameter {
+    using id = Id;
+
+    template <class T>
+    using pass = T &&;
+
+    using pass_default = void;
+
+    static constexpr bool is_keyword = IsKeyword;
+    static constexpr bool is_default = true;
+    static constexpr bool takes_preceding = false;
 };
 
+template <class>
+struct is_var_positional : std::false_type {};
+
+template <class Id>
+struct is_var_positional<var_parameter<Id, false>> : std::true_type {};
+
+template <class>
+struct is_var_keyword : std::false_type {};
+
+template <class Id>
+struct is_var_keyword<var_parameter<Id, true>> : std::true_type {};
+
+template <class Param>
+inline constexpr bool is_var_parameter_v = is_var_positional<Param>::value || is_var_keyword<Param>::value;
+
 template <class>
 struct is_parameter : std::false_type {};
 
@@ -130,29 +417,99 @@ struct is_parameter<parameter<Id, Pass, IsKeyword>> : std::true_type {};
 template <class Id, class Pass, bool IsKeyword, class Def>
 struct is_parameter<default_parameter<Id, Pass, IsKeyword, Def>> : std::true_type {};
 
+template <class Id, class Pass, bool IsKeyword, class F>
+struct is_parameter<lazy_default_parameter<Id, Pass, IsKeyword, F>> : std::true_type {};
+
+template <class Id, bool IsKeyword>
+struct is_parameter<var_parameter<Id, IsKeyword>> : std::true_type {};
+
+template <class Id, class Pass, bool IsKeyword>
+struct is_parameter<optional_parameter<Id, Pass, IsKeyword>> : std::true_type {};
+
 template <class T>
 inline constexpr bool is_parameter_v = is_parameter<T>::value;
 
+template <class>
+struct is_constant : std::false_type {};
+
+template <class T, T V>
+struct is_constant<std::integral_constant<T, V>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_constant_v = is_constant<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+
+// A compile-time constant is passed by value, so that its type is kept by the parameter.
 struct forward_pass {
     template <class T>
-    using apply = T &&;
+    using apply = std::conditional_t<is_constant_v<T>, std::remove_cv_t<std::remove_reference_t<T>>, T &&>;
 
     template <class T>
     using apply_default = std::conditional_t<
-        !std::is_move_constructible_v<T>,
-        type_error<not_movable<T>>,
-        T
+        is_constant_v<T>,
+        std::remove_cv_t<std::remove_reference_t<T>>,
+        std::conditional_t<
+            !std::is_move_constructible_v<T>,
+            type_error<not_movable<T>>,
+            T
+        >
     >;
 };
 
-template <class Type>
-struct convert_pass {
-    template <class T>
-    using apply = std::conditional_t<
+template <class ...Args>
+struct emplace_args;
+
+template <class Type, class T, class Decayed = std::remove_cv_t<std::remove_reference_t<T>>>
+struct convert_val {
+    using type = std::conditional_t<
         !std::is_convertible_v<T, Type>,
         type_error<not_convertible<T, Type>>,
         Type
     >;
+};
+
+template <class T>
+constexpr bool is_negative(T val) {
+    if constexpr (std::is_enum_v<T>) {
+        return is_negative(static_cast<std::underlying_type_t<T>>(val));
+    } else if constexpr (std::is_signed_v<T>) {
+        return val < 0;
+    } else {
+        return false;
+    }
+}
+
+template <class Type, class T, class U, U V, bool = std::is_integral_v<Type> || std::is_enum_v<Type>>
+struct convert_constant {
+    using type = typename convert_val<Type, T, void>::type;
+};
+
+template <class Type, class T, class U, U V>
+struct convert_constant<Type, T, U, V, true> {
+    using type = std::conditional_t<
+        !std::is_convertible_v<T, Type> || static_cast<U>(static_cast<Type>(V)) != V || is_negative(V) != is_negative(static_cast<Type>(V)),
+        type_error<not_convertible<T, Type>>,
+        std::integral_constant<Type, static_cast<Type>(V)>
+    >;
+};
+
+// A compile-time constant converted without loss, keeping its sign, to an integral or enumeration type is still a compile-time constant.
+template <class Type, class T, class U, U V>
+struct convert_val<Type, T, std::integral_constant<U, V>> : convert_constant<Type, T, U, V> {};
+
+// Only an object can be constructed in place; a reference would be bound to a temporary.
+template <class Type, class T, class ...Args>
+struct convert_val<Type, T, emplace_args<Args...>> {
+    using type = std::conditional_t<
+        std::is_reference_v<Type> || !std::is_constructible_v<Type, Args...>,
+        type_error<not_constructible<Type, Args...>>,
+        Type
+    >;
+};
+
+template <class Type>
+struct convert_pass {
+    template <class T>
+    using apply = typename convert_val<Type, T>::type;
 
     template <class T>
     using apply_default = apply<T>;
@@ -181,16 +538,48 @@ struct validate_pass {
 
 /* Arguments */
 
+template <class Val>
+using held_t = std::conditional_t<
+    std::conjunction_v<std::negation<std::is_reference<Val>>, hold_by_value<Val>>,
+    Val,
+    Val &&
+>;
+
+// A value held by value cannot be moved out of a const argument, and is copied instead.
+template <class Val>
+using const_val_t = std::conditional_t<std::is_reference_v<held_t<Val>>, Val &&, Val>;
+
+// A runtime value known to be one of Vs, e.g. 'keywords::x = among<4, 8, 16>(n)', which dispatch_invoke() replaces with constant<V>.
+template <class T, T ...Vs>
+struct among_value {
+    static constexpr std::size_t size = sizeof...(Vs);
+
+    T val;
+};
+
+template <class>
+struct is_among : std::false_type {};
+
+template <class T, T ...Vs>
+struct is_among<among_value<T, Vs...>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_among_v = is_among<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+
 template <class Val>
 struct argument {
     using value_type = Val;
 
     static constexpr bool is_keyword = false;
 
-    Val &&_val;
+    held_t<Val> _val;
 
-    constexpr Val &&val() const && {
-        return std::forward<Val>(_val);
+    FLEXARGS_INLINE constexpr Val &&val() && {
+        return static_cast<Val &&>(_val);
+    }
+
+    FLEXARGS_INLINE constexpr const_val_t<Val> val() const && {
+        return static_cast<const_val_t<Val>>(_val);
     }
 };
 
@@ -201,133 +590,298 @@ struct keyword_argument {
 
     static constexpr bool is_keyword = true;
 
-    Val &&_val;
+    held_t<Val> _val;
+
+    FLEXARGS_INLINE constexpr Val &&val() && {
+        return static_cast<Val &&>(_val);
+    }
+
+    FLEXARGS_INLINE constexpr const_val_t<Val> val() const && {
+        return static_cast<const_val_t<Val>>(_val);
+    }
+};
+
+// References to the parameters and arguments passed to match(), each of which can be accessed without recursion.
+template <std::size_t I, class T>
+struct indexed_ref {
+    T &&ref;
+};
+
+template <class Indices, class ...Ts>
+struct ref_pack_i;
+
+template <std::size_t ...Indices, class ...Ts>
+struct ref_pack_i<std::index_sequence<Indices...>, Ts...> : indexed_ref<Indices, Ts>... {};
+
+template <class ...Ts>
+using ref_pack = ref_pack_i<std::index_sequence_for<Ts...>, Ts...>;
+
+template <std::size_t I, class T>
+FLEXARGS_INLINE constexpr T &&get_ref(indexed_ref<I, T> const &r) {
+    return std::forward<T>(r.ref);
+}
+
+// The arguments received by a var parameter, referenced as they were passed to match().
+// 'std::move(args).apply(f)' calls 'f' with them, e.g. to pass them to another function taking keyword arguments.
+template <class ...Ts>
+struct var_args {
+    ref_pack<Ts...> _refs;
+
+    template <class F>
+    FLEXARGS_INLINE constexpr decltype(auto) apply(F &&f) && {
+        return apply_i(std::forward<F>(f), std::index_sequence_for<Ts...>());
+    }
+
+    template <class F, std::size_t ...Indices>
+    FLEXARGS_INLINE constexpr decltype(auto) apply_i(F &&f, std::index_sequence<Indices...>) {
+        return std::forward<F>(f)(get_ref<Indices>(_refs)...);
+    }
+};
+
+// The arguments of a constructor, e.g. 'keywords::x = emplace(1, 2)', from which a parameter 'parameter<T>(keywords::x)' is constructed in place.
+template <class ...Args>
+struct emplace_args {
+    ref_pack<Args...> _args;
+
+    template <class T>
+    FLEXARGS_INLINE constexpr T construct() && {
+        return construct_i<T>(std::index_sequence_for<Args...>());
+    }
 
-    constexpr Val &&val() const && {
-        return std::forward<Val>(_val);
+    template <class T, std::size_t ...Indices>
+    FLEXARGS_INLINE constexpr T construct_i(std::index_sequence<Indices...>) {
+        return T(get_ref<Indices>(_args)...);
     }
 };
 
+template <class>
+struct is_emplace_args : std::false_type {};
+
+template <class ...Args>
+struct is_emplace_args<emplace_args<Args...>> : std::true_type {};
+
+// Whether a parameter of type T, which is not a reference, is constructed from Val in place.
+template <class T, class Val>
+inline constexpr bool constructs_in_place_v = !std::is_reference_v<T> && is_emplace_args<std::remove_cv_t<std::remove_reference_t<Val>>>::value;
+
+/* Type lists */
+
+// Parameters and arguments are split, validated and matched as lists of types, and their values are touched only in the construction.
+template <class ...Ts>
+struct type_list {};
+
+template <class T>
+struct type_tag {
+    using type = T;
+};
+
+template <std::size_t I, class T>
+struct indexed_type {};
+
+template <class Indices, class ...Ts>
+struct indexed_types_i;
+
+template <std::size_t ...Indices, class ...Ts>
+struct indexed_types_i<std::index_sequence<Indices...>, Ts...> : indexed_type<Indices, Ts>... {};
+
+template <std::size_t I, class T>
+type_tag<T> type_at_i(indexed_type<I, T> const *);
+
+template <std::size_t I, class List>
+struct type_at;
+
+template <std::size_t I, class ...Ts>
+struct type_at<I, type_list<Ts...>> {
+    using type = typename decltype(type_at_i<I>(static_cast<indexed_types_i<std::index_sequence_for<Ts...>, Ts...> const *>(nullptr)))::type;
+};
+
+template <std::size_t I, class List>
+using type_at_t = typename type_at<I, List>::type;
+
+template <class List>
+struct list_size;
+
+template <class ...Ts>
+struct list_size<type_list<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <class List>
+inline constexpr std::size_t list_size_v = list_size<List>::value;
+
 /* Splitters */
 
 template <std::size_t N>
 inline constexpr std::integral_constant<std::size_t, N> size_c = {};
 
-template <class ParamsAndArgs, class Index>
-constexpr auto find_non_param_i([[maybe_unused]] ParamsAndArgs &params_and_args, [[maybe_unused]] Index index) {
-    if constexpr (Index::value >= std::tuple_size_v<ParamsAndArgs>) {
-        return index;
-    } else if constexpr (!is_parameter_v<std::remove_reference_t<std::tuple_element_t<Index::value, ParamsAndArgs>>>) {
-        return index;
-    } else {
-        return find_non_param_i(params_and_args, size_c<Index::value + 1>);
+template <std::size_t N>
+constexpr std::size_t find_first(std::array<bool, N> const &bs, bool b) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (bs[i] == b) {
+            return i;
+        }
     }
+    return N;
 }
 
-template <class ParamsAndArgs>
-constexpr auto find_non_param(ParamsAndArgs &&params_and_args) {
-    return find_non_param_i(params_and_args, size_c<0>);
-}
+template <std::size_t N>
+struct index_list {
+    std::array<std::size_t, N> indices;
+    std::size_t size;
+};
 
-template <class Val>
-constexpr argument<Val> to_arg(Val &&val) {
-    return {std::forward<Val>(val)};
+template <std::size_t N>
+constexpr index_list<N> find_all(std::array<bool, N> const &bs) {
+    index_list<N> r = {};
+    for (std::size_t i = 0; i < N; ++i) {
+        if (bs[i]) {
+            r.indices[r.size++] = i;
+        }
+    }
+    return r;
 }
 
+// An argument passed by value or lvalue reference is a non-keyword argument, and a keyword argument passed by rvalue is a keyword argument.
+template <class ParamOrArg>
+struct to_arg {
+    using type = argument<ParamOrArg>;
+};
+
 template <class Id, class Val>
-constexpr keyword_argument<Id, Val> to_arg(keyword_argument<Id, Val> &&arg) {
-    return std::move(arg);
-}
+struct to_arg<keyword_argument<Id, Val>> {
+    using type = keyword_argument<Id, Val>;
+};
 
-template <class ParamsAndArgs, std::size_t ...ParamIndices, std::size_t ...ArgIndices>
-constexpr auto split_params_and_args_i(ParamsAndArgs &&params_and_args, std::index_sequence<ParamIndices...>, std::index_sequence<ArgIndices...>) {
-    return std::make_tuple(
-        std::make_tuple(std::get<ParamIndices>(std::move(params_and_args))...),
-        std::make_tuple(to_arg(std::get<sizeof...(ParamIndices) + ArgIndices>(std::move(params_and_args)))...)
-    );
-}
+template <class ParamOrArg>
+using to_arg_t = typename to_arg<ParamOrArg>::type;
 
-template <class ParamsAndArgs>
-constexpr auto split_params_and_args(ParamsAndArgs &&params_and_args) {
-    auto index = find_non_param(params_and_args);
-    return split_params_and_args_i(
-        std::move(params_and_args),
-        std::make_index_sequence<decltype(index)::value>(),
-        std::make_index_sequence<std::tuple_size_v<ParamsAndArgs> - decltype(index)::value>()
-    );
-}
+template <class ParamsAndArgs, class ParamIndices, class ArgIndices>
+struct split_params_and_args_i;
+
+template <class ...ParamsAndArgs, std::size_t ...ParamIndices, std::size_t ...ArgIndices>
+struct split_params_and_args_i<type_list<ParamsAndArgs...>, std::index_sequence<ParamIndices...>, std::index_sequence<ArgIndices...>> {
+    using params_t = type_list<std::decay_t<type_at_t<ParamIndices, type_list<ParamsAndArgs...>>>...>;
+    using args_t = type_list<to_arg_t<type_at_t<sizeof...(ParamIndices) + ArgIndices, type_list<ParamsAndArgs...>>>...>;
+};
+
+// ParamsAndArgs are the types deduced for the forwarding references of match().
+template <class ...ParamsAndArgs>
+struct split_params_and_args : split_params_and_args_i<
+    type_list<ParamsAndArgs...>,
+    std::make_index_sequence<find_first(std::array<bool, sizeof...(ParamsAndArgs)>{is_parameter_v<std::remove_reference_t<ParamsAndArgs>>...}, false)>,
+    std::make_index_sequence<sizeof...(ParamsAndArgs) - find_first(std::array<bool, sizeof...(ParamsAndArgs)>{is_parameter_v<std::remove_reference_t<ParamsAndArgs>>...}, false)>
+> {};
 
 /* Validators */
 
-template <class Params, class Pred, class Index>
-constexpr auto validate_each_i([[maybe_unused]] Params &params, [[maybe_unused]] Pred &pred, Index) {
-    if constexpr (Index::value >= std::tuple_size_v<Params>) {
+// Each predicate is instantiated independently, and the first error is returned.
+template <class ...Ts, class Pred>
+constexpr auto validate_each(type_list<Ts...>, [[maybe_unused]] Pred pred) {
+    constexpr std::size_t index = find_first(std::array<bool, sizeof...(Ts)>{is_error_v<decltype(pred(type_tag<Ts>()))>...}, true);
+    if constexpr (index == sizeof...(Ts)) {
         return nullptr;
     } else {
-        auto np = pred(std::get<Index::value>(params));
-        if constexpr (is_error_v<decltype(np)>) {
-            return np;
-        } else {
-            return validate_each_i(params, pred, size_c<Index::value + 1>);
-        }
+        return pred(type_tag<type_at_t<index, type_list<Ts...>>>());
     }
 }
 
-template <class Params, class Pred>
-constexpr auto validate_each(Params &&params, Pred &&pred) {
-    return validate_each_i(params, pred, size_c<0>);
-}
-
-template <class Params, class Pred, class Index>
-constexpr auto validate_each_adjacent_i([[maybe_unused]] Params &params, [[maybe_unused]] Pred &pred, Index) {
-    if constexpr (Index::value + 1 >= std::tuple_size_v<Params>) {
+template <class List, class Pred, std::size_t ...Indices>
+constexpr auto validate_each_adjacent_i([[maybe_unused]] Pred &pred, std::index_sequence<Indices...>) {
+    constexpr std::size_t index = find_first(std::array<bool, sizeof...(Indices)>{is_error_v<decltype(pred(type_tag<type_at_t<Indices, List>>(), type_tag<type_at_t<Indices + 1, List>>()))>...}, true);
+    if constexpr (index == sizeof...(Indices)) {
         return nullptr;
     } else {
-        auto np = pred(std::get<Index::value>(params), std::get<Index::value + 1>(params));
-        if constexpr (is_error_v<decltype(np)>) {
-            return np;
-        } else {
-            return validate_each_adjacent_i(params, pred, size_c<Index::value + 1>);
-        }
+        return pred(type_tag<type_at_t<index, List>>(), type_tag<type_at_t<index + 1, List>>());
     }
 }
 
-template <class Params, class Pred>
-constexpr auto validate_each_adjacent(Params &&params, Pred &&pred) {
-    return validate_each_adjacent_i(params, pred, size_c<0>);
+template <class ...Ts, class Pred>
+constexpr auto validate_each_adjacent(type_list<Ts...>, Pred pred) {
+    return validate_each_adjacent_i<type_list<Ts...>>(pred, std::make_index_sequence<sizeof...(Ts) == 0 ? 0 : sizeof...(Ts) - 1>());
 }
 
-template <class Params, class Pred, class Index1, class Index2>
-constexpr auto validate_each_combination_i([[maybe_unused]] Params &params, [[maybe_unused]] Pred &pred, [[maybe_unused]] Index1 index1, Index2) {
-    if constexpr (Index1::value >= std::tuple_size_v<Params>) {
-        return nullptr;
-    } else if constexpr (Index2::value >= std::tuple_size_v<Params>) {
-        return validate_each_combination_i(params, pred, size_c<Index1::value + 1>, size_c<Index1::value + 2>);
-    } else {
-        auto np = pred(std::get<Index1::value>(params), std::get<Index2::value>(params));
-        if constexpr (is_error_v<decltype(np)>) {
-            return np;
-        } else {
-            return validate_each_combination_i(params, pred, index1, size_c<Index2::value + 1>);
-        }
-    }
-}
+template <std::size_t I, class Id>
+struct indexed_id {};
 
-template <class Params, class Pred>
-constexpr auto validate_each_combination(Params &&params, Pred &&pred) {
-    return validate_each_combination_i(params, pred, size_c<0>, size_c<1>);
-}
+template <class Indices, class ...Ids>
+struct id_set_i;
 
-template <class Params>
-constexpr auto validate_params(Params &&params) {
-    auto np1 = validate_each(params, [](auto &param) {
-        using param_t = std::remove_reference_t<decltype(param)>;
+template <std::size_t ...Indices, class ...Ids>
+struct id_set_i<std::index_sequence<Indices...>, Ids...> : indexed_id<Indices, Ids>... {};
+
+template <class ...Ids>
+using id_set = id_set_i<std::index_sequence_for<Ids...>, Ids...>;
+
+// Deduction of I fails if Id appears more than once in the set.
+template <class Id, std::size_t I>
+constexpr std::size_t find_id(indexed_id<I, Id> const *) {
+    return I;
+}
+
+template <std::size_t I, class Id>
+Id id_at(indexed_id<I, Id> const *);
+
+template <class IdSet, class Id, class = void>
+struct is_unique_id : std::false_type {};
+
+template <class IdSet, class Id>
+struct is_unique_id<IdSet, Id, std::void_t<decltype(find_id<Id>(static_cast<IdSet const *>(nullptr)))>> : std::true_type {};
+
+template <template <class> class Error, class ...Ids>
+constexpr auto validate_unique_ids() {
+    if constexpr (sizeof...(Ids) == 0) {
+        return nullptr;
+    } else {
+        constexpr std::size_t index = find_first(std::array<bool, sizeof...(Ids)>{is_unique_id<id_set<Ids...>, Ids>::value...}, false);
+        if constexpr (index == sizeof...(Ids)) {
+            return nullptr;
+        } else {
+            return syntax_error<Error<decltype(id_at<index>(static_cast<id_set<Ids...> const *>(nullptr)))>>();
+        }
+    }
+}
+
+template <std::size_t>
+struct anonymous_id {};
+
+template <class Arg, std::size_t Index>
+struct argument_id {
+    using type = anonymous_id<Index>;
+};
+
+template <class Id, class Val, std::size_t Index>
+struct argument_id<keyword_argument<Id, Val>, Index> {
+    using type = Id;
+};
+
+template <class ...Params>
+constexpr auto validate_unique_params(type_list<Params...>) {
+    return validate_unique_ids<duplicate_parameter, typename Params::id...>();
+}
+
+template <class ...Args, std::size_t ...ArgIndices>
+constexpr auto validate_unique_args_i(type_list<Args...>, std::index_sequence<ArgIndices...>) {
+    return validate_unique_ids<duplicate_argument, typename argument_id<Args, ArgIndices>::type...>();
+}
+
+template <class ...Args>
+constexpr auto validate_unique_args(type_list<Args...> args) {
+    return validate_unique_args_i(args, std::index_sequence_for<Args...>());
+}
+
+template <class Params>
+constexpr auto validate_params(Params params) {
+    auto np1 = validate_each(params, [](auto param) {
+        using param_t = typename decltype(param)::type;
         if constexpr (param_t::is_default) {
-            using param_val_t = typename param_t::pass_default;
-            if constexpr (is_error_v<param_val_t>) {
-                return param_val_t();
-            } else {
+            // A default value depending on the preceding parameters is validated after matching.
+            if constexpr (param_t::takes_preceding) {
                 return nullptr;
+            } else {
+                using param_val_t = typename param_t::pass_default;
+                if constexpr (is_error_v<param_val_t>) {
+                    return param_val_t();
+                } else {
+                    return nullptr;
+                }
             }
         } else {
             return nullptr;
@@ -336,10 +890,14 @@ constexpr auto validate_params(Params &&params) {
     if constexpr (is_error_v<decltype(np1)>) {
         return np1;
     } else {
-        auto np2 = validate_each_adjacent(params, [](auto &param1, auto &param2) {
-            using param1_t = std::remove_reference_t<decltype(param1)>;
-            using param2_t = std::remove_reference_t<decltype(param2)>;
-            if constexpr (!param1_t::is_keyword) {
+        auto np2 = validate_each_adjacent(params, [](auto param1, auto param2) {
+            using param1_t = typename decltype(param1)::type;
+            using param2_t = typename decltype(param2)::type;
+            if constexpr (is_var_keyword<param1_t>::value) {
+                return syntax_error<parameter_after_var_keyword_parameter<typename param2_t::id>>();
+            } else if constexpr (is_var_positional<param1_t>::value && !param2_t::is_keyword) {
+                return syntax_error<non_keyword_parameter_after_var_positional_parameter<typename param2_t::id>>();
+            } else if constexpr (!param1_t::is_keyword) {
                 if constexpr (!param1_t::is_default) {
                     return nullptr;
                 } else {
@@ -350,7 +908,7 @@ constexpr auto validate_params(Params &&params) {
                     }
                 }
             } else {
-                if constexpr (!param2_t::is_default) {
+                if constexpr (!param2_t::is_default || is_var_positional<param2_t>::value) {
                     return syntax_error<non_keyword_parameter_after_keyword_parameter<typename param2_t::id>>();
                 } else {
                     return nullptr;
@@ -360,24 +918,16 @@ constexpr auto validate_params(Params &&params) {
         if constexpr (is_error_v<decltype(np2)>) {
             return np2;
         } else {
-            return validate_each_combination(params, [](auto &param1, auto &param2) {
-                using param1_t = std::remove_reference_t<decltype(param1)>;
-                using param2_t = std::remove_reference_t<decltype(param2)>;
-                if constexpr (std::is_same_v<typename param1_t::id, typename param2_t::id>) {
-                    return syntax_error<duplicate_parameter<typename param2_t::id>>();
-                } else {
-                    return nullptr;
-                }
-            });
+            return validate_unique_params(params);
         }
     }
 }
 
 template <class Args>
-constexpr auto validate_args(Args &&args) {
-    auto np = validate_each_adjacent(args, [](auto &arg1, auto &arg2) {
-        using arg1_t = std::remove_reference_t<decltype(arg1)>;
-        using arg2_t = std::remove_reference_t<decltype(arg2)>;
+constexpr auto validate_args(Args args) {
+    auto np = validate_each_adjacent(args, [](auto arg1, auto arg2) {
+        using arg1_t = typename decltype(arg1)::type;
+        using arg2_t = typename decltype(arg2)::type;
         if constexpr (arg1_t::is_keyword && !arg2_t::is_keyword) {
             return syntax_error<non_keyword_argument_after_keyword_argument>();
         } else {
@@ -387,19 +937,7 @@ constexpr auto validate_args(Args &&args) {
     if constexpr (is_error_v<decltype(np)>) {
         return np;
     } else {
-        return validate_each_combination(args, [](auto &arg1, auto &arg2) {
-            using arg1_t = std::remove_reference_t<decltype(arg1)>;
-            using arg2_t = std::remove_reference_t<decltype(arg2)>;
-            if constexpr (arg1_t::is_keyword && arg2_t::is_keyword) {
-                if constexpr (std::is_same_v<typename arg1_t::id, typename arg2_t::id>) {
-                    return syntax_error<duplicate_argument<typename arg2_t::id>>();
-                } else {
-                    return nullptr;
-                }
-            } else {
-                return nullptr;
-            }
-        });
+        return validate_unique_args(args);
     }
 }
 
@@ -407,162 +945,1060 @@ constexpr auto validate_args(Args &&args) {
 
 inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
-template <std::size_t>
-constexpr auto initialize_param_ctors_ii() {
-    return size_c<npos>;
-}
+enum class match_error {
+    none,
+    extra_non_keyword_argument,
+    extra_keyword_argument,
+    duplicate_argument,
+    missing_argument
+};
+
+template <std::size_t ParamCount, std::size_t ArgCount>
+struct match_plan {
+    // The index of the argument passed to each parameter, or npos if the default value is used.
+    std::array<std::size_t, ParamCount> param_ctors;
+    // The index of the parameter each argument is passed to, or npos if it is not matched.
+    std::array<std::size_t, ArgCount> arg_params;
+    match_error error;
+    // The index of the argument causing the error, or the parameter for missing_argument.
+    std::size_t error_index;
+};
 
-template <std::size_t ...ParamIndices>
-constexpr auto initialize_param_ctors_i(std::index_sequence<ParamIndices...>) {
-    return std::make_tuple(initialize_param_ctors_ii<ParamIndices>()...);
+template <std::size_t ParamCount, std::size_t ArgCount>
+constexpr match_plan<ParamCount, ArgCount> make_match_plan(
+    std::array<bool, ParamCount> const &param_is_keyword,
+    std::array<bool, ParamCount> const &param_is_default,
+    std::array<bool, ArgCount> const &arg_is_keyword,
+    std::array<std::size_t, ArgCount> const &arg_keyword_params,
+    std::size_t var_positional_param,
+    std::size_t var_keyword_param
+) {
+    match_plan<ParamCount, ArgCount> plan = {};
+    for (std::size_t i = 0; i < ParamCount; ++i) {
+        plan.param_ctors[i] = npos;
+    }
+    for (std::size_t i = 0; i < ArgCount; ++i) {
+        plan.arg_params[i] = npos;
+    }
+    plan.error = match_error::none;
+    std::size_t param_index = 0;
+    for (std::size_t arg_index = 0; arg_index < ArgCount; ++arg_index) {
+        if (!arg_is_keyword[arg_index]) {
+            if (param_index == var_positional_param) {
+                plan.arg_params[arg_index] = param_index;
+                continue;
+            }
+            if (param_index >= ParamCount || param_is_keyword[param_index]) {
+                plan.error = match_error::extra_non_keyword_argument;
+                plan.error_index = arg_index;
+                return plan;
+            }
+            plan.param_ctors[param_index] = arg_index;
+            plan.arg_params[arg_index] = param_index;
+            ++param_index;
+        } else {
+            std::size_t keyword_param_index = arg_keyword_params[arg_index];
+            if (keyword_param_index == npos && var_keyword_param != npos) {
+                plan.arg_params[arg_index] = var_keyword_param;
+                continue;
+            }
+            if (keyword_param_index == npos) {
+                plan.error = match_error::extra_keyword_argument;
+                plan.error_index = arg_index;
+                return plan;
+            }
+            plan.arg_params[arg_index] = keyword_param_index;
+            if (plan.param_ctors[keyword_param_index] != npos) {
+                plan.error = match_error::duplicate_argument;
+                plan.error_index = arg_index;
+                return plan;
+            }
+            plan.param_ctors[keyword_param_index] = arg_index;
+        }
+    }
+    for (std::size_t i = 0; i < ParamCount; ++i) {
+        if (!param_is_default[i] && plan.param_ctors[i] == npos) {
+            plan.error = match_error::missing_argument;
+            plan.error_index = i;
+            return plan;
+        }
+    }
+    return plan;
 }
 
-template <class Params>
-constexpr auto initialize_param_ctors(Params &&) {
-    return initialize_param_ctors_i(std::make_index_sequence<std::tuple_size_v<std::remove_reference_t<Params>>>());
+// The index of the parameter named Id in IdSet, found by the deduction of find_id() in constant time, or npos.
+template <class IdSet, class Id, class = void>
+struct find_keyword_param : std::integral_constant<std::size_t, npos> {};
+
+template <class IdSet, class Id>
+struct find_keyword_param<IdSet, Id, std::void_t<decltype(find_id<Id>(static_cast<IdSet const *>(nullptr)))>>
+    : std::integral_constant<std::size_t, find_id<Id>(static_cast<IdSet const *>(nullptr))> {};
+
+template <std::size_t N>
+constexpr std::size_t find_first_or_npos(std::array<bool, N> const &bs) {
+    std::size_t index = find_first(bs, true);
+    return index == N ? npos : index;
 }
 
-template <class ParamCtors, class Params, class Index>
-constexpr auto finalize_param_ctors_i([[maybe_unused]] ParamCtors param_ctors, [[maybe_unused]] Params &params, Index) {
-    if constexpr (Index::value >= std::tuple_size_v<ParamCtors>) {
-        return param_ctors;
+// A keyword argument is never matched by the name of a var parameter.
+template <class Param>
+struct keyword_param_id {
+    using type = typename Param::id;
+};
+
+template <class Id, bool IsKeyword>
+struct keyword_param_id<var_parameter<Id, IsKeyword>> {
+    using type = var_parameter<Id, IsKeyword>;
+};
+
+template <class Params, class Args>
+struct match_plan_of;
+
+template <class ...Params, class ...Args>
+struct match_plan_of<type_list<Params...>, type_list<Args...>> {
+    // The parameters are unique, which is validated before matching.
+    using param_ids_t = id_set<typename keyword_param_id<Params>::type...>;
+
+    template <std::size_t ...ArgIndices>
+    static constexpr auto make(std::index_sequence<ArgIndices...>) {
+        return make_match_plan<sizeof...(Params), sizeof...(Args)>(
+            {Params::is_keyword...},
+            {Params::is_default...},
+            {Args::is_keyword...},
+            {find_keyword_param<param_ids_t, typename argument_id<Args, ArgIndices>::type>::value...},
+            find_first_or_npos(std::array<bool, sizeof...(Params)>{is_var_positional<Params>::value...}),
+            find_first_or_npos(std::array<bool, sizeof...(Params)>{is_var_keyword<Params>::value...})
+        );
+    }
+
+    static constexpr match_plan<sizeof...(Params), sizeof...(Args)> value = make(std::index_sequence_for<Args...>());
+};
+
+// The matching of parameters and arguments is computed once per pair of types.
+template <class Params, class Args>
+inline constexpr auto const &match_plan_v = match_plan_of<Params, Args>::value;
+
+// A value among compile-time values must be dispatched by dispatch_invoke() before it is matched, except by a var parameter passing it on.
+template <class Params, class Args, std::size_t ArgIndex, std::size_t ParamIndex = match_plan_v<Params, Args>.arg_params[ArgIndex]>
+struct arg_param_val {
+    using param_t = type_at_t<ParamIndex, Params>;
+    using val_t = typename type_at_t<ArgIndex, Args>::value_type;
+    using type = std::conditional_t<
+        is_among_v<val_t> && !is_var_parameter_v<param_t>,
+        type_error<not_dispatched<val_t>>,
+        typename param_t::template pass<val_t>
+    >;
+};
+
+template <class Params, class Args, std::size_t ArgIndex>
+struct arg_param_val<Params, Args, ArgIndex, npos> {
+    using type = void;
+};
+
+template <class Params, class Args, std::size_t ...ArgIndices>
+constexpr auto match_params_and_args_i(std::index_sequence<ArgIndices...>) {
+    constexpr auto &plan = match_plan_v<Params, Args>;
+    // Arguments are matched until the first syntax error, and a type error of an argument matched before it takes precedence.
+    constexpr std::size_t type_error_index = find_first(std::array<bool, sizeof...(ArgIndices)>{is_error_v<typename arg_param_val<Params, Args, ArgIndices>::type>...}, true);
+    if constexpr (type_error_index != sizeof...(ArgIndices)) {
+        return typename arg_param_val<Params, Args, type_error_index>::type();
+    } else if constexpr (plan.error == match_error::extra_non_keyword_argument) {
+        return syntax_error<extra_non_keyword_argument>();
+    } else if constexpr (plan.error == match_error::extra_keyword_argument) {
+        return syntax_error<extra_keyword_argument<typename type_at_t<plan.error_index, Args>::id>>();
+    } else if constexpr (plan.error == match_error::duplicate_argument) {
+        return syntax_error<duplicate_argument<typename type_at_t<plan.error_index, Args>::id>>();
+    } else if constexpr (plan.error == match_error::missing_argument) {
+        return syntax_error<missing_argument<typename type_at_t<plan.error_index, Params>::id>>();
     } else {
-        using param_t = std::tuple_element_t<Index::value, Params>;
-        using param_ctor = std::tuple_element_t<Index::value, ParamCtors>;
-        if constexpr (!param_t::is_default && param_ctor::value == npos) {
-            return syntax_error<missing_argument<typename param_t::id>>();
-        } else {
-            return finalize_param_ctors_i(param_ctors, params, size_c<Index::value + 1>);
-        }
+        return nullptr;
     }
 }
 
-template <class ParamCtors, class Params>
-constexpr auto finalize_param_ctors(ParamCtors param_ctors, Params &&params) {
-    return finalize_param_ctors_i(param_ctors, params, size_c<0>);
+template <class Params, class Args>
+constexpr auto match_params_and_args(Params, Args) {
+    return match_params_and_args_i<Params, Args>(std::make_index_sequence<list_size_v<Args>>());
+}
+
+template <class Params, class Args, std::size_t ParamIndex, std::size_t ArgIndex = match_plan_v<Params, Args>.param_ctors[ParamIndex]>
+struct param_val {
+    template <class ...PrecedingVals>
+    using type = typename type_at_t<ParamIndex, Params>::template pass<typename type_at_t<ArgIndex, Args>::value_type>;
+};
+
+template <class Params, class Args, std::size_t ParamIndex, class Param = type_at_t<ParamIndex, Params>>
+struct default_param_val {
+    template <class ...PrecedingVals>
+    using type = typename Param::template pass_default_for<PrecedingVals...>;
+};
+
+template <class Params, class Args, std::size_t ParamIndex>
+struct param_val<Params, Args, ParamIndex, npos> : default_param_val<Params, Args, ParamIndex> {};
+
+template <class Params, class Args, std::size_t ParamIndex, std::size_t ...ArgIndices>
+constexpr auto find_var_args(std::index_sequence<ArgIndices...>) {
+    return find_all(std::array<bool, sizeof...(ArgIndices)>{(match_plan_v<Params, Args>.arg_params[ArgIndices] == ParamIndex)...});
 }
 
-template <class ParamCtors, class ParamIndex, class ArgIndex, class CurParamIndex>
-constexpr auto update_param_ctors_ii([[maybe_unused]] ParamCtors param_ctors, ParamIndex, [[maybe_unused]] ArgIndex arg_index, CurParamIndex) {
-    if constexpr (CurParamIndex::value == ParamIndex::value) {
-        return arg_index;
+template <class Params, class Args, std::size_t ParamIndex>
+inline constexpr index_list<list_size_v<Args>> var_arg_indices_v = find_var_args<Params, Args, ParamIndex>(std::make_index_sequence<list_size_v<Args>>());
+
+// The type passed to match() for each argument.
+template <class Arg>
+struct passed_arg;
+
+template <class Val>
+struct passed_arg<argument<Val>> {
+    using type = Val;
+};
+
+template <class Id, class Val>
+struct passed_arg<keyword_argument<Id, Val>> {
+    using type = keyword_argument<Id, Val>;
+};
+
+template <class Params, class Args, std::size_t ParamIndex, class Indices = std::make_index_sequence<var_arg_indices_v<Params, Args, ParamIndex>.size>>
+struct var_args_of;
+
+template <class Params, class Args, std::size_t ParamIndex, std::size_t ...Indices>
+struct var_args_of<Params, Args, ParamIndex, std::index_sequence<Indices...>> {
+    using type = var_args<typename passed_arg<type_at_t<var_arg_indices_v<Params, Args, ParamIndex>.indices[Indices], Args>>::type...>;
+
+    template <class Refs>
+    static FLEXARGS_INLINE constexpr type make(Refs &refs) {
+        return {{{get_ref<list_size_v<Params> + var_arg_indices_v<Params, Args, ParamIndex>.indices[Indices]>(refs)}...}};
+    }
+};
+
+template <class Params, class Args, std::size_t ParamIndex, class Id, bool IsKeyword>
+struct default_param_val<Params, Args, ParamIndex, var_parameter<Id, IsKeyword>> {
+    template <class ...PrecedingVals>
+    using type = typename var_args_of<Params, Args, ParamIndex>::type;
+};
+
+template <class Params, class Args, std::size_t ParamIndex>
+constexpr bool takes_preceding_i() {
+    if constexpr (match_plan_v<Params, Args>.param_ctors[ParamIndex] != npos) {
+        return false;
     } else {
-        return std::get<CurParamIndex::value>(param_ctors);
+        return type_at_t<ParamIndex, Params>::takes_preceding;
     }
 }
 
-template <class ParamCtors, class ParamIndex, class ArgIndex, std::size_t ...ParamIndices>
-constexpr auto update_param_ctors_i(ParamCtors param_ctors, ParamIndex param_index, ArgIndex arg_index, std::index_sequence<ParamIndices...>) {
-    return std::make_tuple(update_param_ctors_ii(param_ctors, param_index, arg_index, size_c<ParamIndices>)...);
+template <class Params, class Args, std::size_t ...ParamIndices>
+constexpr bool takes_preceding(std::index_sequence<ParamIndices...>) {
+    return (false || ... || takes_preceding_i<Params, Args, ParamIndices>());
 }
 
-template <class ParamCtors, class ParamIndex, class ArgIndex>
-constexpr auto update_param_ctors(ParamCtors param_ctors, ParamIndex param_index, ArgIndex arg_index) {
-    return update_param_ctors_i(param_ctors, param_index, arg_index, std::make_index_sequence<std::tuple_size_v<ParamCtors>>());
+// Whether a default value depending on the preceding parameters is used, in which case the parameters are constructed one by one.
+template <class Params, class Args>
+inline constexpr bool takes_preceding_v = takes_preceding<Params, Args>(std::make_index_sequence<list_size_v<Params>>());
+
+// The types of the parameters, each of which may depend on the preceding ones.
+// They are accumulated by a fold expression, whose instantiation depth does not grow with the number of the parameters, and the accumulation stops at the first error.
+template <class ...Vals>
+struct param_vals {};
+
+template <class Error>
+struct param_vals_error {};
+
+template <class Params, class Args, std::size_t ParamIndex>
+struct param_step {};
+
+template <class ...Vals, class Params, class Args, std::size_t ParamIndex, class Val = typename param_val<Params, Args, ParamIndex>::template type<Vals...>>
+std::conditional_t<is_error_v<Val>, param_vals_error<Val>, param_vals<Vals..., Val>> operator+(param_vals<Vals...>, param_step<Params, Args, ParamIndex>);
+
+template <class Error, class Params, class Args, std::size_t ParamIndex>
+param_vals_error<Error> operator+(param_vals_error<Error>, param_step<Params, Args, ParamIndex>);
+
+template <class Params, class Args, std::size_t ...ParamIndices>
+auto fold_param_vals(std::index_sequence<ParamIndices...>) -> decltype((param_vals<>() + ... + param_step<Params, Args, ParamIndices>()));
+
+template <class Params, class Args>
+using param_vals_t = decltype(fold_param_vals<Params, Args>(std::make_index_sequence<list_size_v<Params>>()));
+
+template <class ...Vals>
+constexpr std::nullptr_t validate_param_vals(param_vals<Vals...>) {
+    return nullptr;
 }
 
-template <class Params, class Arg, class Index>
-constexpr auto find_keyword_param_i([[maybe_unused]] Params &params, [[maybe_unused]] Arg &arg, [[maybe_unused]] Index index) {
-    if constexpr (Index::value >= std::tuple_size_v<Params>) {
-        return syntax_error<extra_keyword_argument<typename Arg::id>>();
+template <class Error>
+constexpr Error validate_param_vals(param_vals_error<Error>) {
+    return {};
+}
+
+template <class Params, class Args>
+constexpr auto validate_and_match(Params params, Args args) {
+    auto np1 = validate_params(params);
+    if constexpr (is_error_v<decltype(np1)>) {
+        return np1;
     } else {
-        using param_t = std::tuple_element_t<Index::value, Params>;
-        if constexpr (std::is_same_v<typename Arg::id, typename param_t::id>) {
-            using param_val_t = typename param_t::template pass<typename Arg::value_type>;
-            if constexpr (is_error_v<param_val_t>) {
-                return param_val_t();
+        auto np2 = validate_args(args);
+        if constexpr (is_error_v<decltype(np2)>) {
+            return np2;
+        } else {
+            auto np3 = match_params_and_args(params, args);
+            if constexpr (is_error_v<decltype(np3)>) {
+                return np3;
+            } else if constexpr (!takes_preceding_v<Params, Args>) {
+                return nullptr;
             } else {
-                return index;
+                return validate_param_vals(param_vals_t<Params, Args>());
             }
+        }
+    }
+}
+
+/* Constructors */
+
+// The result of match(), a flat aggregate which structured bindings decompose with get<I>().
+template <std::size_t I, class T>
+struct result_element {
+    T _val;
+};
+
+template <class Indices, class ...Ts>
+struct result_i;
+
+template <std::size_t ...Indices, class ...Ts>
+struct result_i<std::index_sequence<Indices...>, Ts...> : result_element<Indices, Ts>... {};
+
+template <class ...Ts>
+using result = result_i<std::index_sequence_for<Ts...>, Ts...>;
+
+template <std::size_t I, class T>
+FLEXARGS_INLINE constexpr T &get(result_element<I, T> &e) {
+    return e._val;
+}
+
+template <std::size_t I, class T>
+FLEXARGS_INLINE constexpr T const &get(result_element<I, T> const &e) {
+    return e._val;
+}
+
+template <std::size_t I, class T>
+FLEXARGS_INLINE constexpr T &&get(result_element<I, T> &&e) {
+    return static_cast<T &&>(e._val);
+}
+
+template <std::size_t I, class T>
+FLEXARGS_INLINE constexpr T const &&get(result_element<I, T> const &&e) {
+    return static_cast<T const &&>(e._val);
+}
+
+template <class Val>
+FLEXARGS_INLINE constexpr Val &&arg_val(Val &&val) {
+    return std::forward<Val>(val);
+}
+
+template <class Id, class Val>
+FLEXARGS_INLINE constexpr Val &&arg_val(keyword_argument<Id, Val> &&arg) {
+    return std::move(arg).val();
+}
+
+template <class Params, class Args, std::size_t ParamIndex, class Refs, class ...PrecedingVals>
+FLEXARGS_INLINE constexpr decltype(auto) construct_param(Refs &refs, [[maybe_unused]] PrecedingVals &...preceding_vals) {
+    using param_val_t = typename param_val<Params, Args, ParamIndex>::template type<PrecedingVals...>;
+    constexpr std::size_t arg_index = match_plan_v<Params, Args>.param_ctors[ParamIndex];
+    if constexpr (is_constant<param_val_t>::value) {
+        // A compile-time constant is not read from the argument or the default value.
+        return param_val_t();
+    } else if constexpr (arg_index == npos && is_var_parameter_v<type_at_t<ParamIndex, Params>>) {
+        return var_args_of<Params, Args, ParamIndex>::make(refs);
+    } else if constexpr (arg_index == npos) {
+        if constexpr (constructs_in_place_v<param_val_t, decltype(std::move(get_ref<ParamIndex>(refs)).def(preceding_vals...))>) {
+            return std::move(get_ref<ParamIndex>(refs)).def(preceding_vals...).template construct<param_val_t>();
+        } else {
+            return static_cast<param_val_t>(std::move(get_ref<ParamIndex>(refs)).def(preceding_vals...));
+        }
+    } else {
+        if constexpr (constructs_in_place_v<param_val_t, decltype(arg_val(get_ref<list_size_v<Params> + arg_index>(refs)))>) {
+            return arg_val(get_ref<list_size_v<Params> + arg_index>(refs)).template construct<param_val_t>();
         } else {
-            return find_keyword_param_i(params, arg, size_c<Index::value + 1>);
+            return static_cast<param_val_t>(arg_val(get_ref<list_size_v<Params> + arg_index>(refs)));
         }
     }
 }
 
-template <class Params, class Arg>
-constexpr auto find_keyword_param(Params &&params, Arg &&arg) {
-    return find_keyword_param_i(params, arg, size_c<0>);
+// The type constructed from the parameters, which is result<Vals...> if Result is void.
+template <class Result, class ...Vals>
+struct result_for {
+    using type = Result;
+};
+
+template <class ...Vals>
+struct result_for<void, Vals...> {
+    using type = result<Vals...>;
+};
+
+template <class Param>
+struct default_source {
+    using type = void;
+};
+
+template <class Id, class Pass, bool IsKeyword, class Def>
+struct default_source<default_parameter<Id, Pass, IsKeyword, Def>> {
+    using type = Def;
+};
+
+// The argument or the default value from which a parameter is constructed.
+template <class Params, class Args, std::size_t ParamIndex, std::size_t ArgIndex = match_plan_v<Params, Args>.param_ctors[ParamIndex]>
+struct param_source {
+    using type = typename type_at_t<ArgIndex, Args>::value_type;
+};
+
+template <class Params, class Args, std::size_t ParamIndex>
+struct param_source<Params, Args, ParamIndex, npos> {
+    using type = typename default_source<type_at_t<ParamIndex, Params>>::type;
+};
+
+template <class Params, class Args, std::size_t ParamIndex, class Refs, class Vals, std::size_t ...PrecedingIndices>
+FLEXARGS_INLINE constexpr decltype(auto) construct_param_after(Refs &refs, Vals &vals, std::index_sequence<PrecedingIndices...>) {
+    return construct_param<Params, Args, ParamIndex>(refs, get<PrecedingIndices>(vals)...);
 }
 
-template <class Params, class ParamIndex, class Args, class ArgIndex, class ParamCtors>
-constexpr auto match_params_and_args_i([[maybe_unused]] Params &params, [[maybe_unused]] ParamIndex param_index, [[maybe_unused]] Args &args, [[maybe_unused]] ArgIndex arg_index, [[maybe_unused]] ParamCtors param_ctors) {
-    if constexpr (ArgIndex::value >= std::tuple_size_v<Args>) {
-        return finalize_param_ctors(param_ctors, params);
+// Each parameter is constructed after the preceding ones, to which it refers in the elements of the result initialized in order, and the result is then moved.
+template <class Params, class Args, class Result, class Refs, class ...Vals, std::size_t ...ParamIndices>
+FLEXARGS_INLINE constexpr auto construct_params_in_order(Refs &refs, param_vals<Vals...>, std::index_sequence<ParamIndices...>) {
+    static_assert(
+        !(constructs_in_place_v<Vals, typename param_source<Params, Args, ParamIndices>::type> || ...),
+        "cpp-flexargs: a parameter constructed in place by emplace() cannot be combined with a lazy default value depending on the preceding parameters"
+    );
+    result<Vals...> vals = {{construct_param_after<Params, Args, ParamIndices>(refs, vals, std::make_index_sequence<ParamIndices>())}...};
+    if constexpr (std::is_void_v<Result>) {
+        return vals;
     } else {
-        using arg_t = std::tuple_element_t<ArgIndex::value, Args>;
-        if constexpr (!arg_t::is_keyword) {
-            if constexpr (ParamIndex::value >= std::tuple_size_v<Params>) {
-                return syntax_error<extra_non_keyword_argument>();
-            } else {
-                using param_t = std::tuple_element_t<ParamIndex::value, Params>;
-                if constexpr (!param_t::is_keyword) {
-                    using param_val_t = typename param_t::template pass<typename arg_t::value_type>;
-                    if constexpr (is_error_v<param_val_t>) {
-                        return param_val_t();
-                    } else {
-                        return match_params_and_args_i(params, size_c<ParamIndex::value + 1>, args, size_c<ArgIndex::value + 1>, update_param_ctors(param_ctors, param_index, arg_index));
-                    }
-                } else {
-                    return syntax_error<extra_non_keyword_argument>();
-                }
+        return Result{get<ParamIndices>(std::move(vals))...};
+    }
+}
+
+// Each parameter is constructed in place, as the prvalue initializing an element of the result.
+template <class Params, class Args, class Result, class Refs, std::size_t ...ParamIndices>
+FLEXARGS_INLINE constexpr auto construct_params_i(Refs &refs, std::index_sequence<ParamIndices...>) {
+    return typename result_for<Result, decltype(construct_param<Params, Args, ParamIndices>(refs))...>::type{
+        construct_param<Params, Args, ParamIndices>(refs)...
+    };
+}
+
+template <class Params, class Args, class Result = void, class Refs>
+FLEXARGS_INLINE constexpr auto construct_params(Refs &refs) {
+    if constexpr (takes_preceding_v<Params, Args>) {
+        return construct_params_in_order<Params, Args, Result>(refs, param_vals_t<Params, Args>(), std::make_index_sequence<list_size_v<Params>>());
+    } else {
+        return construct_params_i<Params, Args, Result>(refs, std::make_index_sequence<list_size_v<Params>>());
+    }
+}
+
+// Constructs the matched parameters for match_as<Result>(), as construct_params() does unless specialized.
+template <class Result>
+struct construct_as {
+    template <class Params, class Args, class Refs>
+    static FLEXARGS_INLINE constexpr auto construct(Refs &refs) {
+        return construct_params<Params, Args, Result>(refs);
+    }
+};
+
+#ifdef FLEXARGS_PROFILE
+
+/* Profilers */
+
+// Each thread counts the calls in its own shard without synchronization, and the shards are summed only by profile_records().
+struct profile_shard;
+
+struct profile_registry {
+    std::mutex mutex;
+    std::vector<profile_record> plans;
+    std::vector<profile_shard *> shards;
+    // The counts of the shards of the finished threads.
+    std::array<std::uint64_t, FLEXARGS_PROFILE_MAX_PLANS> retired = {};
+};
+
+inline profile_registry &get_profile_registry() {
+    static profile_registry registry;
+    return registry;
+}
+
+struct profile_shard {
+    std::array<std::atomic<std::uint64_t>, FLEXARGS_PROFILE_MAX_PLANS> counts = {};
+
+    profile_shard() {
+        auto &registry = get_profile_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.shards.push_back(this);
+    }
+
+    ~profile_shard() {
+        auto &registry = get_profile_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (std::size_t i = 0; i < FLEXARGS_PROFILE_MAX_PLANS; ++i) {
+            registry.retired[i] += counts[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < registry.shards.size(); ++i) {
+            if (registry.shards[i] == this) {
+                registry.shards.erase(registry.shards.begin() + i);
+                break;
             }
+        }
+    }
+};
+
+template <class T>
+std::string profile_type_name() {
+    char const *name = typeid(type_tag<T>).name();
+#if __has_include(<cxxabi.h>)
+    int status = 0;
+    std::unique_ptr<char, void (*)(void *)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+    if (status == 0) {
+        // Strip the enclosing type_tag<...>.
+        std::string s = demangled.get();
+        std::size_t first = s.find('<');
+        return first == std::string::npos ? s : s.substr(first + 1, s.size() - first - 2);
+    }
+#endif
+    return name;
+}
+
+template <class Arg>
+std::string profile_arg_name() {
+    if constexpr (Arg::is_keyword) {
+        return profile_type_name<typename Arg::id>();
+    } else {
+        return {};
+    }
+}
+
+template <class Params, class Args>
+struct profile_plan;
+
+template <class ...Params, class ...Args>
+struct profile_plan<type_list<Params...>, type_list<Args...>> {
+    template <std::size_t ...ParamIndices>
+    static std::size_t add(std::index_sequence<ParamIndices...>) {
+        constexpr auto &plan = match_plan_v<type_list<Params...>, type_list<Args...>>;
+        auto &registry = get_profile_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.plans.push_back({
+            {profile_type_name<typename Params::id>()...},
+            {profile_arg_name<Args>()...},
+            {(plan.param_ctors[ParamIndices] == npos)...},
+            0,
+            registry.plans.size() >= FLEXARGS_PROFILE_MAX_PLANS
+        });
+        return registry.plans.size() - 1;
+    }
+
+    // Registered on the first call.
+    static std::size_t index() {
+        static std::size_t const i = add(std::index_sequence_for<Params...>());
+        return i;
+    }
+};
+
+template <class Params, class Args>
+void profile_match() {
+    thread_local profile_shard shard;
+    std::size_t i = profile_plan<Params, Args>::index();
+    if (i < FLEXARGS_PROFILE_MAX_PLANS) {
+        // Only this thread writes to the shard, so no read-modify-write is needed.
+        shard.counts[i].store(shard.counts[i].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    } else {
+        auto &registry = get_profile_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        ++registry.plans[i].calls;
+    }
+}
+
+inline void write_json_string(std::ostream &os, std::string const &s) {
+    char const digits[] = "0123456789abcdef";
+    os << '"';
+    for (char c : s) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (u < 0x20) {
+            os << "\\u00" << digits[u >> 4] << digits[u & 0xf];
         } else {
-            auto keyword_param_index = find_keyword_param(params, std::get<ArgIndex::value>(args));
-            if constexpr (is_error_v<decltype(keyword_param_index)>) {
-                return keyword_param_index;
-            } else {
-                using keyword_param_ctor = std::tuple_element_t<decltype(keyword_param_index)::value, ParamCtors>;
-                if constexpr (keyword_param_ctor::value != npos) {
-                    return syntax_error<duplicate_argument<typename arg_t::id>>();
-                } else {
-                    return match_params_and_args_i(params, param_index, args, size_c<ArgIndex::value + 1>, update_param_ctors(param_ctors, keyword_param_index, arg_index));
-                }
-            }
+            os << c;
         }
     }
+    os << '"';
 }
 
+#endif
+
+// Counts a call of match() if FLEXARGS_PROFILE is defined and the call is evaluated at runtime.
 template <class Params, class Args>
-constexpr auto match_params_and_args(Params &&params, Args &&args) {
-    return match_params_and_args_i(params, size_c<0>, args, size_c<0>, initialize_param_ctors(params));
+FLEXARGS_INLINE constexpr void profile_call() {
+#ifdef FLEXARGS_PROFILE
+    if (!FLEXARGS_IS_CONSTANT_EVALUATED()) {
+        profile_match<Params, Args>();
+    }
+#endif
+}
+
+/* Forwarders */
+
+template <class Arg, class Ids>
+struct is_forwarded_keyword : std::false_type {};
+
+template <class Id, class Val, class ...Ids>
+struct is_forwarded_keyword<keyword_argument<Id, Val>, type_list<Ids...>> : std::disjunction<std::is_same<Id, Ids>...> {};
+
+template <class Ids, class ...Args>
+inline constexpr index_list<sizeof...(Args)> forwarded_indices_v = find_all(std::array<bool, sizeof...(Args)>{is_forwarded_keyword<Args, Ids>::value...});
+
+template <class Ids, std::size_t ...Indices, class ...Args>
+FLEXARGS_INLINE constexpr auto forward_keywords_i(std::index_sequence<Indices...>, [[maybe_unused]] Args &&...args) {
+    constexpr auto &indices = forwarded_indices_v<Ids, Args...>;
+    [[maybe_unused]] ref_pack<Args...> refs = {{std::forward<Args>(args)}...};
+    return var_args<type_at_t<indices.indices[Indices], type_list<Args...>>...>{{{get_ref<indices.indices[Indices]>(refs)}...}};
 }
 
-template <class Param, class Args, class ArgIndex>
-constexpr decltype(auto) construct_params_ii([[maybe_unused]] Param &&param, [[maybe_unused]] Args &&args, ArgIndex) {
-    if constexpr (!Param::is_default) {
-        using param_val_t = typename Param::template pass<typename std::tuple_element_t<ArgIndex::value, Args>::value_type>;
-        return static_cast<param_val_t>(std::get<ArgIndex::value>(std::move(args)).val());
+/* Batches */
+
+template <class>
+struct is_column : std::false_type {};
+
+template <class T>
+struct is_column<column_view<T>> : std::true_type {};
+
+template <class>
+struct is_keyword_argument : std::false_type {};
+
+template <class Id, class Val>
+struct is_keyword_argument<keyword_argument<Id, Val>> : std::true_type {};
+
+template <class Arg>
+using batch_val_t = std::remove_cv_t<std::remove_reference_t<Arg>>;
+
+template <class Arg>
+struct is_column_argument : is_column<Arg> {};
+
+template <class Id, class Val>
+struct is_column_argument<keyword_argument<Id, Val>> : is_column<batch_val_t<Val>> {};
+
+template <class Arg>
+inline constexpr bool is_column_argument_v = is_column_argument<batch_val_t<Arg>>::value;
+
+template <class Arg>
+FLEXARGS_INLINE constexpr std::size_t column_rows(Arg const &arg) {
+    if constexpr (is_keyword_argument<Arg>::value) {
+        return column_rows(arg._val);
+    } else if constexpr (is_column<Arg>::value) {
+        return arg.size;
     } else {
-        if constexpr (ArgIndex::value == npos) {
-            using param_val_t = typename Param::pass_default;
-            return static_cast<param_val_t>(std::move(param).def());
-        } else {
-            using param_val_t = typename Param::template pass<typename std::tuple_element_t<ArgIndex::value, Args>::value_type>;
-            return static_cast<param_val_t>(std::get<ArgIndex::value>(std::move(args)).val());
+        return npos;
+    }
+}
+
+// The argument for a row: an element of a column, or a scalar broadcast by reference to every row.
+template <class Arg>
+FLEXARGS_INLINE constexpr decltype(auto) row_arg(Arg &arg, [[maybe_unused]] std::size_t row) {
+    if constexpr (is_keyword_argument<std::remove_cv_t<Arg>>::value) {
+        using val_t = decltype(row_arg(arg._val, row));
+        return keyword_argument<typename Arg::id, val_t>{row_arg(arg._val, row)};
+    } else if constexpr (is_column<std::remove_cv_t<Arg>>::value) {
+        return (arg.data[row]);
+    } else {
+        return (arg);
+    }
+}
+
+// The argument for all rows: a column truncated to the rows, or a scalar as it is.
+template <class Arg>
+FLEXARGS_INLINE constexpr decltype(auto) column_arg(Arg &&arg, [[maybe_unused]] std::size_t rows) {
+    using arg_t = batch_val_t<Arg>;
+    if constexpr (is_keyword_argument<arg_t>::value && is_column_argument<arg_t>::value) {
+        return keyword_argument<typename arg_t::id, batch_val_t<typename arg_t::value_type>>{{arg._val.data, rows}};
+    } else if constexpr (is_column<arg_t>::value) {
+        return arg_t{arg.data, rows};
+    } else {
+        return std::forward<Arg>(arg);
+    }
+}
+
+template <class ...Args>
+FLEXARGS_INLINE constexpr std::size_t batch_rows(Args const &...args) {
+    std::size_t rows = npos;
+    ((rows = column_rows(args) < rows ? column_rows(args) : rows), ...);
+    return rows;
+}
+
+/* Captures */
+
+template <class>
+struct is_var_args : std::false_type {};
+
+template <class ...Ts>
+struct is_var_args<var_args<Ts...>> : std::true_type {};
+
+template <class>
+struct is_reference_wrapper : std::false_type {};
+
+template <class T>
+struct is_reference_wrapper<std::reference_wrapper<T>> : std::true_type {};
+
+// The type holding a parameter in a capture: a reference is decayed to a value, and std::reference_wrapper is kept as a reference.
+template <class Val>
+using captured_t = std::decay_t<Val>;
+
+template <class Val>
+FLEXARGS_INLINE constexpr decltype(auto) unwrap_captured(Val &&val) {
+    if constexpr (is_reference_wrapper<std::remove_cv_t<std::remove_reference_t<Val>>>::value) {
+        return val.get();
+    } else {
+        return std::forward<Val>(val);
+    }
+}
+
+// The indices of the parameters stably sorted by alignment in descending order, so that the fields are padded as little as possible.
+template <std::size_t N>
+constexpr std::array<std::size_t, N> sort_by_alignment(std::array<std::size_t, N> const &alignments) {
+    std::array<std::size_t, N> order = {};
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t j = i;
+        for (; j > 0 && alignments[order[j - 1]] < alignments[i]; --j) {
+            order[j] = order[j - 1];
         }
+        order[j] = i;
     }
+    return order;
 }
 
-template <class Params, class Args, class ParamCtors, std::size_t ...ParamIndices>
-constexpr auto construct_params_i(Params &&params, Args &&args, ParamCtors param_ctors, std::index_sequence<ParamIndices...>) {
-    return std::tuple<decltype(construct_params_ii(std::get<ParamIndices>(std::move(params)), std::move(args), std::get<ParamIndices>(param_ctors)))...>(
-        construct_params_ii(std::get<ParamIndices>(std::move(params)), std::move(args), std::get<ParamIndices>(param_ctors))...
-    );
+template <std::size_t N>
+constexpr std::array<std::size_t, N> invert(std::array<std::size_t, N> const &order) {
+    std::array<std::size_t, N> positions = {};
+    for (std::size_t i = 0; i < N; ++i) {
+        positions[order[i]] = i;
+    }
+    return positions;
 }
 
-template <class Params, class Args, class ParamCtors>
-constexpr auto construct_params(Params &&params, Args &&args, ParamCtors param_ctors) {
-    return construct_params_i(std::move(params), std::move(args), param_ctors, std::make_index_sequence<std::tuple_size_v<ParamCtors>>());
+template <class ...Vals>
+inline constexpr std::array<std::size_t, sizeof...(Vals)> capture_order_v = sort_by_alignment(std::array<std::size_t, sizeof...(Vals)>{alignof(captured_t<Vals>)...});
+
+template <class Param>
+struct is_lazy_default_parameter : std::false_type {};
+
+template <class Id, class Pass, bool IsKeyword, class F>
+struct is_lazy_default_parameter<lazy_default_parameter<Id, Pass, IsKeyword, F>> : std::true_type {};
+
+template <class Params, class Args, std::size_t ...ParamIndices>
+constexpr bool takes_lazy_default(std::index_sequence<ParamIndices...>) {
+    return (false || ... || (match_plan_v<Params, Args>.param_ctors[ParamIndices] == npos && is_lazy_default_parameter<type_at_t<ParamIndices, Params>>::value));
 }
 
+// Whether a lazy default value is used, which is then computed in the order of the parameters as in match().
 template <class Params, class Args>
-constexpr auto match_i(Params &&params, Args &&args) {
-    auto param_ctors = match_params_and_args(params, args);
-    if constexpr (is_error_v<decltype(param_ctors)>) {
-        return param_ctors;
+inline constexpr bool takes_lazy_default_v = takes_lazy_default<Params, Args>(std::make_index_sequence<list_size_v<Params>>());
+
+template <class Vals, class Indices>
+struct capture_of;
+
+// The parameters owned by a capture, stored in the order of capture_order_v and passed in their own order.
+template <class ...Vals, std::size_t ...Indices>
+struct capture_of<type_list<Vals...>, std::index_sequence<Indices...>> {
+    static constexpr auto &order = capture_order_v<Vals...>;
+    static constexpr std::array<std::size_t, sizeof...(Vals)> positions = invert(order);
+
+    using type = result<captured_t<type_at_t<order[Indices], type_list<Vals...>>>...>;
+
+    template <class Params, class Args, class Refs>
+    static FLEXARGS_INLINE constexpr type make(Refs &refs) {
+        if constexpr (takes_preceding_v<Params, Args> || takes_lazy_default_v<Params, Args>) {
+            // The parameters are constructed in their order, and then moved into their fields.
+            auto vals = construct_params<Params, Args>(refs);
+            return {{static_cast<captured_t<type_at_t<order[Indices], type_list<Vals...>>>>(get<order[Indices]>(std::move(vals)))}...};
+        } else {
+            return {{construct_param<Params, Args, order[Indices]>(refs)}...};
+        }
+    }
+
+    template <class F, class Fields>
+    static FLEXARGS_INLINE constexpr decltype(auto) apply(F &&f, Fields &&fields) {
+        return std::forward<F>(f)(unwrap_captured(get<positions[Indices]>(std::forward<Fields>(fields)))...);
+    }
+};
+
+template <class Vals>
+struct capture_vals;
+
+template <std::size_t ...Indices, class ...Vals>
+struct capture_vals<result_i<std::index_sequence<Indices...>, Vals...>> {
+    using type = type_list<Vals...>;
+};
+
+template <class ...Vals>
+struct capture {
+    using capture_of_t = capture_of<type_list<Vals...>, std::index_sequence_for<Vals...>>;
+
+    typename capture_of_t::type _fields;
+
+    template <class F>
+    FLEXARGS_INLINE constexpr decltype(auto) apply(F &&f) & {
+        return capture_of_t::apply(std::forward<F>(f), _fields);
+    }
+
+    template <class F>
+    FLEXARGS_INLINE constexpr decltype(auto) apply(F &&f) const & {
+        return capture_of_t::apply(std::forward<F>(f), _fields);
+    }
+
+    template <class F>
+    FLEXARGS_INLINE constexpr decltype(auto) apply(F &&f) && {
+        return capture_of_t::apply(std::forward<F>(f), std::move(_fields));
+    }
+};
+
+template <class Vals>
+struct capture_for;
+
+template <class ...Vals>
+struct capture_for<type_list<Vals...>> {
+    using type = capture<Vals...>;
+
+    static_assert(!(is_var_args<std::remove_cv_t<std::remove_reference_t<Vals>>>::value || ...), "cpp-flexargs: a var parameter cannot be captured");
+    static_assert(!(is_emplace_args<std::remove_cv_t<std::remove_reference_t<Vals>>>::value || ...), "cpp-flexargs: emplace() can be captured only by a parameter with a type");
+    static_assert(
+        !(std::is_array_v<std::remove_reference_t<Vals>> || ...) && !(std::is_function_v<std::remove_reference_t<Vals>> || ...),
+        "cpp-flexargs: an array or a function can be captured only by a parameter with a type"
+    );
+};
+
+// The Result of match_as() constructing a capture.
+struct capture_tag {};
+
+template <>
+struct construct_as<capture_tag> {
+    template <class Params, class Args, class Refs>
+    static FLEXARGS_INLINE constexpr auto construct(Refs &refs) {
+        using vals_t = typename capture_vals<decltype(construct_params<Params, Args>(refs))>::type;
+        using capture_t = typename capture_for<vals_t>::type;
+        return capture_t{capture_t::capture_of_t::template make<Params, Args>(refs)};
+    }
+};
+
+/* Dispatchers */
+
+template <class T>
+FLEXARGS_INLINE constexpr unsigned long long among_key(T val) {
+    return static_cast<unsigned long long>(val);
+}
+
+// Whether Vs are consecutive, in which case the index of a value is computed by a subtraction.
+template <class T, T ...Vs>
+constexpr bool is_consecutive(among_value<T, Vs...>) {
+    unsigned long long const keys[] = {among_key(Vs)...};
+    for (std::size_t i = 0; i < sizeof...(Vs); ++i) {
+        if (keys[i] != keys[0] + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The index of the value in Vs, or sizeof...(Vs) if it is not found.
+template <class T, T ...Vs>
+FLEXARGS_INLINE constexpr std::size_t among_index(among_value<T, Vs...> a) {
+    unsigned long long const keys[] = {among_key(Vs)...};
+    if constexpr (is_consecutive(among_value<T, Vs...>())) {
+        unsigned long long const i = among_key(a.val) - keys[0];
+        return i < sizeof...(Vs) ? static_cast<std::size_t>(i) : sizeof...(Vs);
+    } else {
+        std::size_t i = 0;
+        while (i < sizeof...(Vs) && keys[i] != among_key(a.val)) {
+            ++i;
+        }
+        return i;
+    }
+}
+
+// The I-th value of Vs as a compile-time constant, or the runtime value if I is sizeof...(Vs).
+template <std::size_t I, class T, T ...Vs>
+FLEXARGS_INLINE constexpr auto among_case([[maybe_unused]] among_value<T, Vs...> a) {
+    if constexpr (I == sizeof...(Vs)) {
+        return a.val;
+    } else {
+        return std::integral_constant<T, std::array<T, sizeof...(Vs)>{Vs...}[I]>();
+    }
+}
+
+template <class Arg>
+FLEXARGS_INLINE constexpr auto among_of(Arg const &arg) {
+    if constexpr (is_keyword_argument<Arg>::value) {
+        return among_of(arg._val);
+    } else {
+        return arg;
+    }
+}
+
+template <std::size_t I, class Arg>
+FLEXARGS_INLINE constexpr auto among_case_arg(Arg const &arg) {
+    if constexpr (is_keyword_argument<Arg>::value) {
+        using val_t = decltype(among_case<I>(among_of(arg)));
+        return keyword_argument<typename Arg::id, val_t>{among_case<I>(among_of(arg))};
+    } else {
+        return among_case<I>(arg);
+    }
+}
+
+template <class Arg>
+struct is_among_argument : is_among<Arg> {};
+
+template <class Id, class Val>
+struct is_among_argument<keyword_argument<Id, Val>> : is_among<batch_val_t<Val>> {};
+
+template <class Arg>
+inline constexpr bool is_among_argument_v = is_among_argument<batch_val_t<Arg>>::value;
+
+// The J-th argument for the I-th case of the K-th argument.
+template <std::size_t K, std::size_t I, std::size_t J, class Refs>
+FLEXARGS_INLINE constexpr decltype(auto) dispatch_arg(Refs &refs) {
+    if constexpr (J == K) {
+        return among_case_arg<I>(get_ref<J>(refs));
     } else {
-        return construct_params(std::move(params), std::move(args), param_ctors);
+        return get_ref<J>(refs);
+    }
+}
+
+template <class F, class ...Args>
+FLEXARGS_INLINE constexpr decltype(auto) dispatch_invoke_i(F &&f, Args &&...args);
+
+template <std::size_t K, std::size_t I, class F, class Refs, std::size_t ...Js>
+FLEXARGS_INLINE constexpr decltype(auto) dispatch_case(F &&f, Refs &refs, std::index_sequence<Js...>) {
+    return dispatch_invoke_i(std::forward<F>(f), dispatch_arg<K, I, Js>(refs)...);
+}
+
+// An entry of the jump table, which is not inlined because its address is taken.
+template <class R, std::size_t K, std::size_t I, class F, class Refs, class Indices>
+constexpr R dispatch_entry(F &&f, Refs &refs) {
+    return dispatch_case<K, I>(std::forward<F>(f), refs, Indices());
+}
+
+template <class R, std::size_t K, class F, class Refs, class Indices, std::size_t ...Is>
+FLEXARGS_INLINE constexpr R dispatch_jump(std::size_t i, F &&f, Refs &refs, std::index_sequence<Is...>) {
+    constexpr R (*table[])(F &&, Refs &) = {&dispatch_entry<R, K, Is, F, Refs, Indices>...};
+    return table[i](std::forward<F>(f), refs);
+}
+
+// The values among compile-time values are dispatched one by one, from the first one, and every case returns the type of the runtime case.
+template <class F, class ...Args>
+FLEXARGS_INLINE constexpr decltype(auto) dispatch_invoke_i(F &&f, Args &&...args) {
+    constexpr std::size_t k = find_first(std::array<bool, sizeof...(Args)>{is_among_argument_v<Args>...}, true);
+    if constexpr (k == sizeof...(Args)) {
+        return std::forward<F>(f)(std::forward<Args>(args)...);
+    } else {
+        using refs_t = ref_pack<Args...>;
+        using indices_t = std::index_sequence_for<Args...>;
+        refs_t refs = {{std::forward<Args>(args)}...};
+        auto const a = among_of(get_ref<k>(refs));
+        constexpr std::size_t n = decltype(a)::size;
+        using r_t = decltype(dispatch_case<k, n>(std::declval<F>(), refs, indices_t()));
+        return dispatch_jump<r_t, k, F, refs_t, indices_t>(among_index(a), std::forward<F>(f), refs, std::make_index_sequence<n + 1>());
+    }
+}
+
+template <class E, std::size_t ...Indices>
+constexpr among_value<E, static_cast<E>(Indices)...> among_enum_i(E val, std::index_sequence<Indices...>) {
+    return {val};
+}
+
+/* Signatures */
+
+template <class ...Params>
+struct signature {
+    std::tuple<Params...> _params;
+};
+
+template <class>
+struct is_signature : std::false_type {};
+
+template <class ...Params>
+struct is_signature<signature<Params...>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_signature_v = is_signature<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+
+template <class Id, class Pass, bool IsKeyword>
+constexpr parameter<Id, Pass, IsKeyword> own_param(parameter<Id, Pass, IsKeyword>) {
+    return {};
+}
+
+template <class Id, bool IsKeyword>
+constexpr var_parameter<Id, IsKeyword> own_param(var_parameter<Id, IsKeyword>) {
+    return {};
+}
+
+template <class Id, class Pass, bool IsKeyword>
+constexpr optional_parameter<Id, Pass, IsKeyword> own_param(optional_parameter<Id, Pass, IsKeyword>) {
+    return {};
+}
+
+// An rvalue default value is moved into the signature, and an lvalue one is referenced.
+template <class Id, class Pass, bool IsKeyword, class Def>
+constexpr auto own_param(default_parameter<Id, Pass, IsKeyword, Def> &&param) {
+    static_assert(!is_emplace_args<std::remove_cv_t<std::remove_reference_t<Def>>>::value, "cpp-flexargs: a default value of a signature cannot be emplace()");
+    return owning_default_parameter<Id, Pass, IsKeyword, std::conditional_t<std::is_lvalue_reference_v<Def>, Def, std::remove_cv_t<Def>>>{std::forward<Def>(param._def)};
+}
+
+template <class Id, class Pass, bool IsKeyword, class F>
+constexpr auto own_param(lazy_default_parameter<Id, Pass, IsKeyword, F> &&param) {
+    return owning_lazy_default_parameter<Id, Pass, IsKeyword, std::conditional_t<std::is_lvalue_reference_v<F>, F, std::remove_cv_t<F>>>{std::forward<F>(param._f)};
+}
+
+template <class NP, class Params, class Args, class Refs>
+struct match_result {
+    using type = NP;
+};
+
+template <class Params, class Args, class Refs>
+struct match_result<std::nullptr_t, Params, Args, Refs> {
+    using type = decltype(construct_params<Params, Args>(std::declval<Refs &>()));
+};
+
+// The validation and matching of a signature and arguments, shared by match(), match_() and match_result_t.
+template <class Sig, class ...Args>
+struct signature_match;
+
+template <class ...Params, class ...Args>
+struct signature_match<signature<Params...>, Args...> {
+    using params_t = type_list<Params...>;
+    using args_t = type_list<to_arg_t<Args>...>;
+    using np_t = decltype(validate_and_match(params_t(), args_t()));
+    using refs_t = ref_pack<Params const &..., Args...>;
+    using result_type = typename match_result<np_t, params_t, args_t, refs_t>::type;
+};
+
+template <class Match, class Result, class ...Params, std::size_t ...ParamIndices, class ...Args>
+FLEXARGS_INLINE constexpr auto match_signature(std::tuple<Params...> const &params, std::index_sequence<ParamIndices...>, Args &&...args) {
+    profile_call<typename Match::params_t, typename Match::args_t>();
+    typename Match::refs_t refs = {{std::get<ParamIndices>(params)}..., {std::forward<Args>(args)}...};
+    return construct_params<typename Match::params_t, typename Match::args_t, Result>(refs);
+}
+
+template <class Result, class Sig, class ...Args>
+FLEXARGS_INLINE constexpr auto match_signature_as(Sig &sig, [[maybe_unused]] Args &&...args) {
+    using match_t = signature_match<std::remove_cv_t<Sig>, Args...>;
+    if constexpr (is_error_v<typename match_t::np_t>) {
+        return typename match_t::np_t();
+    } else {
+        return match_signature<match_t, Result>(sig._params, std::make_index_sequence<list_size_v<typename match_t::params_t>>(), std::forward<Args>(args)...);
+    }
+}
+
+/* Matchers */
+
+template <class Result, class ...ParamsAndArgs>
+FLEXARGS_INLINE constexpr auto match_as([[maybe_unused]] ParamsAndArgs &&...params_and_args) {
+    using params_t = typename split_params_and_args<ParamsAndArgs...>::params_t;
+    using args_t = typename split_params_and_args<ParamsAndArgs...>::args_t;
+    using np_t = decltype(validate_and_match(params_t(), args_t()));
+    if constexpr (is_error_v<np_t>) {
+        return np_t();
+    } else {
+        profile_call<params_t, args_t>();
+        ref_pack<ParamsAndArgs...> refs = {{std::forward<ParamsAndArgs>(params_and_args)}...};
+        return construct_as<Result>::template construct<params_t, args_t>(refs);
     }
 }
 
@@ -575,12 +2011,12 @@ struct keyword {
     using id = Id;
 
     template <class Val>
-    constexpr detail::keyword_argument<Id, Val> operator=(Val &&val) const {
+    FLEXARGS_INLINE constexpr detail::keyword_argument<Id, Val> operator=(Val &&val) const {
         return {std::forward<Val>(val)};
     }
 
     template <class T>
-    constexpr detail::keyword_argument<Id, std::initializer_list<T>> operator=(std::initializer_list<T> &&il) const {
+    FLEXARGS_INLINE constexpr detail::keyword_argument<Id, std::initializer_list<T>> operator=(std::initializer_list<T> &&il) const {
         return {std::move(il)};
     }
 };
@@ -588,58 +2024,291 @@ struct keyword {
 /* Parameters */
 
 template <class Id>
-constexpr detail::parameter<Id, detail::forward_pass, false> parameter(keyword<Id>) {
+FLEXARGS_INLINE constexpr detail::parameter<Id, detail::forward_pass, false> parameter(keyword<Id>) {
     return {};
 }
 
 template <class Type, class Id>
-constexpr detail::parameter<Id, detail::convert_pass<Type>, false> parameter(keyword<Id>) {
+FLEXARGS_INLINE constexpr detail::parameter<Id, detail::convert_pass<Type>, false> parameter(keyword<Id>) {
     return {};
 }
 
 template <template <class> class Constraint, class Id>
-constexpr detail::parameter<Id, detail::validate_pass<Constraint>, false> parameter(keyword<Id>) {
+FLEXARGS_INLINE constexpr detail::parameter<Id, detail::validate_pass<Constraint>, false> parameter(keyword<Id>) {
     return {};
 }
 
 template <class Id>
-constexpr detail::parameter<Id, detail::forward_pass, true> keyword_parameter(keyword<Id>) {
+FLEXARGS_INLINE constexpr detail::parameter<Id, detail::forward_pass, true> keyword_parameter(keyword<Id>) {
     return {};
 }
 
 template <class Type, class Id>
-constexpr detail::parameter<Id, detail::convert_pass<Type>, true> keyword_parameter(keyword<Id>) {
+FLEXARGS_INLINE constexpr detail::parameter<Id, detail::convert_pass<Type>, true> keyword_parameter(keyword<Id>) {
     return {};
 }
 
 template <template <class> class Constraint, class Id>
-constexpr detail::parameter<Id, detail::validate_pass<Constraint>, true> keyword_parameter(keyword<Id>) {
+FLEXARGS_INLINE constexpr detail::parameter<Id, detail::validate_pass<Constraint>, true> keyword_parameter(keyword<Id>) {
+    return {};
+}
+
+// A parameter which is absent_t if the argument is not passed, e.g. 'optional_parameter(keywords::callback)'.
+template <class Id>
+FLEXARGS_INLINE constexpr detail::optional_parameter<Id, detail::forward_pass, false> optional_parameter(keyword<Id>) {
+    return {};
+}
+
+template <class Type, class Id>
+FLEXARGS_INLINE constexpr detail::optional_parameter<Id, detail::convert_pass<Type>, false> optional_parameter(keyword<Id>) {
     return {};
 }
 
+template <template <class> class Constraint, class Id>
+FLEXARGS_INLINE constexpr detail::optional_parameter<Id, detail::validate_pass<Constraint>, false> optional_parameter(keyword<Id>) {
+    return {};
+}
+
+template <class Id>
+FLEXARGS_INLINE constexpr detail::optional_parameter<Id, detail::forward_pass, true> optional_keyword_parameter(keyword<Id>) {
+    return {};
+}
+
+template <class Type, class Id>
+FLEXARGS_INLINE constexpr detail::optional_parameter<Id, detail::convert_pass<Type>, true> optional_keyword_parameter(keyword<Id>) {
+    return {};
+}
+
+template <template <class> class Constraint, class Id>
+FLEXARGS_INLINE constexpr detail::optional_parameter<Id, detail::validate_pass<Constraint>, true> optional_keyword_parameter(keyword<Id>) {
+    return {};
+}
+
+// A parameter receiving the extra non-keyword arguments, like '*args' in Python.
+template <class Id>
+FLEXARGS_INLINE constexpr detail::var_parameter<Id, false> var_positional(keyword<Id>) {
+    return {};
+}
+
+// A parameter receiving the unknown keyword arguments, like '**kwargs' in Python.
+template <class Id>
+FLEXARGS_INLINE constexpr detail::var_parameter<Id, true> var_keyword(keyword<Id>) {
+    return {};
+}
+
+// A compile-time constant passed as an argument or a default value, e.g. 'keywords::width = constant<8>'.
+// A parameter receives it as 'std::integral_constant', which the callee can use in 'if constexpr'.
+template <auto V>
+inline constexpr std::integral_constant<decltype(V), V> constant = {};
+
+// Whether T, with cv-qualifiers and references removed, is 'std::integral_constant', i.e. a parameter received a compile-time constant.
+using detail::is_constant_v;
+
+// Constructor arguments of a parameter 'parameter<T>(...)', which is then constructed in place without being moved.
+// The arguments are referenced, so they must outlive the call.
+template <class ...Args>
+FLEXARGS_INLINE constexpr detail::emplace_args<Args...> emplace(Args &&...args) {
+    return {{{std::forward<Args>(args)}...}};
+}
+
+// A default value computed only when it is used, e.g. 'parameter(keywords::x) = lazy([] { return std::string(...); })'.
+// If 'f' is not invocable with no arguments, it is invoked with the preceding parameters.
+template <class F>
+FLEXARGS_INLINE constexpr detail::lazy_default<F> lazy(F &&f) {
+    return {std::forward<F>(f)};
+}
+
+/* Results */
+
+using detail::get;
+
+/* Signatures */
+
+// A parameter list declared once and shared by match() and match_(), e.g. 'inline constexpr auto sig = signature(parameter(keywords::x), parameter(keywords::y) = 0)'.
+// The signature owns the default values passed as rvalues.
+template <class ...Params>
+FLEXARGS_INLINE constexpr detail::signature<decltype(detail::own_param(std::declval<Params>()))...> signature(Params &&...params) {
+    return {{detail::own_param(std::forward<Params>(params))...}};
+}
+
+// The result type of 'match(sig, std::declval<Args>()...)', where 'Sig' is the type of 'sig'.
+template <class Sig, class ...Args>
+using match_result_t = typename detail::signature_match<std::remove_cv_t<std::remove_reference_t<Sig>>, Args...>::result_type;
+
 /* Matchers */
 
+// Only the construction of the parameters is evaluated at runtime.
+// The splitting, validation and matching are done on types.
 template <class ...ParamsAndArgs>
-constexpr auto match(ParamsAndArgs &&...params_and_args) {
-    auto [params, args] = detail::split_params_and_args(std::forward_as_tuple(std::forward<ParamsAndArgs>(params_and_args)...));
-    auto np1 = detail::validate_params(params);
-    if constexpr (detail::is_error_v<decltype(np1)>) {
-        return np1;
-    } else {
-        auto np2 = detail::validate_args(args);
-        if constexpr (detail::is_error_v<decltype(np2)>) {
-            return np2;
-        } else {
-            return detail::match_i(std::move(params), std::move(args));
-        }
-    }
+FLEXARGS_INLINE constexpr auto match(ParamsAndArgs &&...params_and_args) {
+    return detail::match_as<void>(std::forward<ParamsAndArgs>(params_and_args)...);
 }
 
 template <class ...ParamsAndArgs>
-constexpr auto match_(ParamsAndArgs &&...params_and_args) -> std::enable_if_t<!detail::is_error_v<decltype(match(std::forward<ParamsAndArgs>(params_and_args)...))>, decltype(match(std::forward<ParamsAndArgs>(params_and_args)...))> {
+FLEXARGS_INLINE constexpr auto match_(ParamsAndArgs &&...params_and_args) -> std::enable_if_t<!detail::is_error_v<decltype(match(std::forward<ParamsAndArgs>(params_and_args)...))>, decltype(match(std::forward<ParamsAndArgs>(params_and_args)...))> {
     return match(std::forward<ParamsAndArgs>(params_and_args)...);
 }
 
+template <class Sig, class ...Args, std::enable_if_t<detail::is_signature_v<Sig>, int> = 0>
+FLEXARGS_INLINE constexpr auto match(Sig &&sig, Args &&...args) {
+    return detail::match_signature_as<void>(sig, std::forward<Args>(args)...);
+}
+
+template <class Sig, class ...Args, std::enable_if_t<detail::is_signature_v<Sig>, int> = 0>
+FLEXARGS_INLINE constexpr auto match_(Sig &&sig, Args &&...args) -> std::enable_if_t<!detail::is_error_v<typename detail::signature_match<std::remove_cv_t<std::remove_reference_t<Sig>>, Args...>::np_t>, match_result_t<Sig, Args...>> {
+    return match(sig, std::forward<Args>(args)...);
+}
+
+// Constructs the aggregate 'Options' from the parameters in order, e.g. 'options opts = match_into<options>(parameter(keywords::x), ..., std::forward<Args>(args)...)'.
+// Each member is initialized directly by the value of the corresponding parameter, without an intermediate result.
+template <class Options, class ...ParamsAndArgs>
+FLEXARGS_INLINE constexpr auto match_into(ParamsAndArgs &&...params_and_args) {
+    static_assert(std::is_aggregate_v<Options>, "cpp-flexargs: match_into() requires an aggregate");
+    return detail::match_as<Options>(std::forward<ParamsAndArgs>(params_and_args)...);
+}
+
+template <class Options, class Sig, class ...Args, std::enable_if_t<detail::is_signature_v<Sig>, int> = 0>
+FLEXARGS_INLINE constexpr auto match_into(Sig &&sig, Args &&...args) {
+    static_assert(std::is_aggregate_v<Options>, "cpp-flexargs: match_into() requires an aggregate");
+    return detail::match_signature_as<Options>(sig, std::forward<Args>(args)...);
+}
+
+/* Captures */
+
+// Matches the parameters and arguments like match(), and returns an object owning the values of the parameters, e.g. to run the call later on another thread.
+// An rvalue is moved and an lvalue is copied into the object, and an argument passed by std::ref() or std::cref() is kept as a reference.
+// 'std::move(c).apply(f)' calls 'f' with the values in the order of the parameters, though they are laid out by alignment to minimize padding.
+template <class ...ParamsAndArgs>
+FLEXARGS_INLINE constexpr auto capture(ParamsAndArgs &&...params_and_args) {
+    return detail::match_as<detail::capture_tag>(std::forward<ParamsAndArgs>(params_and_args)...);
+}
+
+/* Forwarders */
+
+// The keyword arguments for the given keywords among 'args', e.g. 'forward_keywords<keywords::x, keywords::y>(std::forward<Args>(args)...)'.
+// They are referenced as they were passed, and the other arguments are ignored.
+template <auto const &...Keywords, class ...Args>
+FLEXARGS_INLINE constexpr auto forward_keywords(Args &&...args) {
+    using ids_t = detail::type_list<typename std::decay_t<decltype(Keywords)>::id...>;
+    return detail::forward_keywords_i<ids_t>(std::make_index_sequence<detail::forwarded_indices_v<ids_t, Args...>.size>(), std::forward<Args>(args)...);
+}
+
+/* Batches */
+
+template <class T>
+FLEXARGS_INLINE constexpr column_view<T> column(T *data, std::size_t size) {
+    return {data, size};
+}
+
+template <class Range>
+FLEXARGS_INLINE constexpr auto column(Range &range) -> column_view<std::remove_pointer_t<decltype(std::data(range))>> {
+    return {std::data(range), std::size(range)};
+}
+
+struct by_columns_t {};
+
+inline constexpr by_columns_t by_columns = {};
+
+// Calls 'f' once per row, e.g. 'batch_invoke(f, keywords::x = column(xs), keywords::y = 1)' calls 'f(keywords::x = xs[i], keywords::y = 1)' for each i.
+// The number of rows is that of the shortest column. Returns the number of rows.
+template <class F, class ...Args>
+FLEXARGS_INLINE constexpr std::size_t batch_invoke(F &&f, Args &&...args) {
+    static_assert((detail::is_column_argument_v<Args> || ...), "cpp-flexargs: batch_invoke() requires at least one column");
+    std::size_t const rows = detail::batch_rows(args...);
+    for (std::size_t row = 0; row < rows; ++row) {
+        f(detail::row_arg(args, row)...);
+    }
+    return rows;
+}
+
+// Calls 'f' once with whole columns truncated to the shortest one, for a function processing columns by itself.
+template <class F, class ...Args>
+FLEXARGS_INLINE constexpr decltype(auto) batch_invoke(by_columns_t, F &&f, Args &&...args) {
+    static_assert((detail::is_column_argument_v<Args> || ...), "cpp-flexargs: batch_invoke() requires at least one column");
+    std::size_t const rows = detail::batch_rows(args...);
+    return std::forward<F>(f)(detail::column_arg(std::forward<Args>(args), rows)...);
+}
+
+/* Dispatchers */
+
+// A runtime value among the compile-time values, e.g. 'keywords::width = among<4, 8, 16>(n)', to be passed to dispatch_invoke().
+template <auto V, decltype(V) ...Vs>
+FLEXARGS_INLINE constexpr detail::among_value<decltype(V), V, Vs...> among(decltype(V) val) {
+    return {val};
+}
+
+// A runtime value among the enumerators E(0), ..., E(N - 1), where N is enum_size<E>::value by default.
+template <class E, std::size_t N = enum_size<E>::value>
+FLEXARGS_INLINE constexpr auto among_enum(E val) {
+    static_assert(std::is_enum_v<E>, "cpp-flexargs: among_enum() requires an enumeration type");
+    return detail::among_enum_i(val, std::make_index_sequence<N>());
+}
+
+// Calls 'f' with the arguments, replacing each value among compile-time values with constant<V> for its value, e.g. 'dispatch_invoke(f, keywords::width = among<4, 8>(n))' calls 'f(keywords::width = constant<8>)' if n is 8.
+// A value not among them is passed as it is. The case is selected through a jump table per value among compile-time values, and every case must return the same type.
+template <class F, class ...Args>
+FLEXARGS_INLINE constexpr decltype(auto) dispatch_invoke(F &&f, Args &&...args) {
+    return detail::dispatch_invoke_i(std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+#ifdef FLEXARGS_PROFILE
+
+/* Profilers */
+
+// The counts of all the threads, summed on demand.
+inline std::vector<profile_record> profile_records() {
+    auto &registry = detail::get_profile_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<profile_record> records = registry.plans;
+    for (std::size_t i = 0; i < records.size() && i < FLEXARGS_PROFILE_MAX_PLANS; ++i) {
+        records[i].calls = registry.retired[i];
+        for (auto shard : registry.shards) {
+            records[i].calls += shard->counts[i].load(std::memory_order_relaxed);
+        }
+    }
+    return records;
+}
+
+// Writes profile_records() as a JSON array, in which a plan beyond FLEXARGS_PROFILE_MAX_PLANS has '"overflowed": true'.
+inline void write_profile_json(std::ostream &os) {
+    auto write_strings = [&](std::vector<std::string> const &strs) {
+        os << "[";
+        for (std::size_t i = 0; i < strs.size(); ++i) {
+            os << (i == 0 ? "" : ", ");
+            if (strs[i].empty()) {
+                os << "null";
+            } else {
+                detail::write_json_string(os, strs[i]);
+            }
+        }
+        os << "]";
+    };
+    auto records = profile_records();
+    os << "[";
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        os << (i == 0 ? "\n" : ",\n") << "  {\"parameters\": ";
+        write_strings(records[i].parameters);
+        os << ", \"arguments\": ";
+        write_strings(records[i].arguments);
+        os << ", \"defaults\": [";
+        for (std::size_t j = 0; j < records[i].defaults.size(); ++j) {
+            os << (j == 0 ? "" : ", ") << (records[i].defaults[j] ? "true" : "false");
+        }
+        os << "], \"calls\": " << records[i].calls << (records[i].overflowed ? ", \"overflowed\": true}" : "}");
+    }
+    os << "\n]\n";
+}
+
+#endif
+
 } // namespace flexargs
 
+template <std::size_t ...Indices, class ...Ts>
+struct std::tuple_size<flexargs::detail::result_i<std::index_sequence<Indices...>, Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, std::size_t ...Indices, class ...Ts>
+struct std::tuple_element<I, flexargs::detail::result_i<std::index_sequence<Indices...>, Ts...>> {
+    using type = flexargs::detail::type_at_t<I, flexargs::detail::type_list<Ts...>>;
+};
+
 #endif
@@ -0,0 +1,410 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLEXARGS_CLI_HPP_INCLUDED
+#define FLEXARGS_CLI_HPP_INCLUDED
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "flexargs.hpp"
+
+namespace flexargs {
+
+/* Command-line errors */
+
+enum class cli_errc {
+    ok,
+    unknown_keyword,
+    missing_value,
+    invalid_value,
+    duplicate_argument,
+    missing_argument,
+    extra_argument
+};
+
+struct cli_error {
+    cli_errc code;
+    // The offending command-line argument, or the name of the parameter for missing_argument.
+    std::string_view arg;
+
+    constexpr explicit operator bool() const {
+        return code != cli_errc::ok;
+    }
+};
+
+namespace detail {
+
+/* Errors */
+
+template <class Id>
+struct unnamed_keyword {};
+
+template <class Id>
+struct duplicate_keyword_name {};
+
+template <class Id>
+struct unsupported_cli_parameter {};
+
+/* Keyword names */
+
+// A keyword has a name if its id has a static data member 'name' convertible to std::string_view.
+template <class Id, class = void>
+struct keyword_name {
+    static constexpr bool has_name = false;
+    static constexpr std::string_view value = {};
+};
+
+template <class Id>
+struct keyword_name<Id, std::void_t<decltype(std::string_view(Id::name))>> {
+    static constexpr bool has_name = true;
+    static constexpr std::string_view value = Id::name;
+};
+
+/* Perfect hashing */
+
+constexpr std::uint32_t cli_hash(std::string_view s, std::uint32_t seed) {
+    std::uint32_t h = 2166136261u ^ seed;
+    for (char c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+struct perfect_hash {
+    std::size_t size;
+    std::uint32_t seed;
+};
+
+// Finds the smallest power-of-two table and a seed with which the names do not collide.
+// The names must be distinct.
+template <std::size_t N>
+constexpr perfect_hash find_perfect_hash(std::array<std::string_view, N> const &names) {
+    std::size_t size = 1;
+    while (size < 2 * N) {
+        size *= 2;
+    }
+    for (; size <= (std::size_t(1) << 20); size *= 2) {
+        for (std::uint32_t seed = 0; seed < 64; ++seed) {
+            std::array<std::uint32_t, N> hashes = {};
+            for (std::size_t i = 0; i < N; ++i) {
+                hashes[i] = cli_hash(names[i], seed) & (size - 1);
+            }
+            bool collides = false;
+            for (std::size_t i = 0; i < N && !collides; ++i) {
+                for (std::size_t j = i + 1; j < N && !collides; ++j) {
+                    collides = hashes[i] == hashes[j];
+                }
+            }
+            if (!collides) {
+                return {size, seed};
+            }
+        }
+    }
+    return {0, 0};
+}
+
+template <std::size_t Size, std::size_t N>
+constexpr std::array<std::size_t, Size> make_perfect_hash_slots(std::array<std::string_view, N> const &names, std::uint32_t seed) {
+    std::array<std::size_t, Size> slots = {};
+    for (std::size_t i = 0; i < Size; ++i) {
+        slots[i] = npos;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        slots[cli_hash(names[i], seed) & (Size - 1)] = i;
+    }
+    return slots;
+}
+
+template <class ...Ids>
+struct cli_keyword_table {
+    static constexpr std::array<std::string_view, sizeof...(Ids)> names = {keyword_name<Ids>::value...};
+    static constexpr perfect_hash hash = find_perfect_hash(names);
+    static_assert(hash.size != 0, "cpp-flexargs: failed to find a perfect hash of keyword names");
+    static constexpr std::array<std::size_t, hash.size> slots = make_perfect_hash_slots<hash.size>(names, hash.seed);
+
+    // Returns the index of the parameter named 'name', or npos.
+    static constexpr std::size_t find(std::string_view name) {
+        std::size_t index = slots[cli_hash(name, hash.seed) & (hash.size - 1)];
+        return index != npos && names[index] == name ? index : npos;
+    }
+};
+
+/* Values */
+
+template <class Param>
+struct param_pass;
+
+template <class Id, class Pass, bool IsKeyword>
+struct param_pass<parameter<Id, Pass, IsKeyword>> {
+    using type = Pass;
+};
+
+template <class Id, class Pass, bool IsKeyword, class Def>
+struct param_pass<default_parameter<Id, Pass, IsKeyword, Def>> {
+    using type = Pass;
+};
+
+template <class Id, class Pass, bool IsKeyword, class F>
+struct param_pass<lazy_default_parameter<Id, Pass, IsKeyword, F>> {
+    using type = Pass;
+};
+
+// Optional and variadic parameters, whose arguments are told apart at compile time, cannot take command-line arguments.
+template <class Param, class = void>
+struct is_cli_parameter : std::false_type {};
+
+template <class Param>
+struct is_cli_parameter<Param, std::void_t<typename param_pass<Param>::type>> : std::true_type {};
+
+// A typed parameter is parsed as its type, and the others are passed as std::string_view.
+template <class Pass>
+struct cli_value {
+    using type = std::string_view;
+};
+
+template <class Type>
+struct cli_value<convert_pass<Type>> {
+    using type = std::remove_cv_t<std::remove_reference_t<Type>>;
+};
+
+template <class Param>
+using cli_value_t = typename cli_value<typename param_pass<Param>::type>::type;
+
+template <class T>
+inline constexpr bool is_cli_parsable_v = std::is_arithmetic_v<T> || std::is_convertible_v<std::string_view, T> || std::is_constructible_v<T, std::string_view>;
+
+template <class T>
+struct parsed_value {
+    T val;
+    bool ok;
+};
+
+template <class T>
+FLEXARGS_INLINE parsed_value<T> parse_cli_value(std::string_view s) {
+    if constexpr (std::is_same_v<T, bool>) {
+        if (s == "true" || s == "1") {
+            return {true, true};
+        } else if (s == "false" || s == "0") {
+            return {false, true};
+        } else {
+            return {false, false};
+        }
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        T val = {};
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), val);
+        return {val, ec == std::errc() && ptr == s.data() + s.size()};
+    } else if constexpr (std::is_convertible_v<std::string_view, T>) {
+        return {s, true};
+    } else {
+        return {T(s), true};
+    }
+}
+
+/* Validators */
+
+template <class Param, class Vals, class Indices>
+struct cli_default;
+
+// The default value of a parameter is converted to the value type of the parameter.
+// A lazy default value is computed from the values of the preceding parameters.
+template <class Param, class ...Vals, std::size_t ...Indices>
+struct cli_default<Param, type_list<Vals...>, std::index_sequence<Indices...>> {
+    using pass_default = typename Param::template pass_default_for<type_at_t<Indices, type_list<Vals...>>...>;
+
+    template <class P = Param>
+    static auto def_type(int) -> decltype(std::declval<P>().def(std::declval<type_at_t<Indices, type_list<Vals...>> &>()...));
+
+    template <class P = Param>
+    static void def_type(...);
+};
+
+template <class Params, class Vals, std::size_t Index>
+constexpr auto validate_cli_param() {
+    using param_t = type_at_t<Index, Params>;
+    using val_t = type_at_t<Index, Vals>;
+    if constexpr (!is_cli_parsable_v<val_t>) {
+        return type_error<not_convertible<std::string_view, val_t>>();
+    } else if constexpr (is_error_v<typename param_t::template pass<val_t>>) {
+        return typename param_t::template pass<val_t>();
+    } else if constexpr (!param_t::is_default) {
+        return nullptr;
+    } else {
+        using cli_default_t = cli_default<param_t, Vals, std::make_index_sequence<Index>>;
+        if constexpr (is_error_v<typename cli_default_t::pass_default>) {
+            return typename cli_default_t::pass_default();
+        } else {
+            using def_t = decltype(cli_default_t::def_type(0));
+            if constexpr (!std::is_constructible_v<val_t, def_t>) {
+                return type_error<not_convertible<def_t, val_t>>();
+            } else {
+                return nullptr;
+            }
+        }
+    }
+}
+
+template <std::size_t N>
+constexpr std::size_t find_duplicate_name(std::array<std::string_view, N> const &names) {
+    for (std::size_t j = 0; j < N; ++j) {
+        for (std::size_t i = 0; i < j; ++i) {
+            if (names[i] == names[j]) {
+                return j;
+            }
+        }
+    }
+    return N;
+}
+
+template <class Params, class Vals, std::size_t ...ParamIndices>
+constexpr auto validate_cli_params_i(std::index_sequence<ParamIndices...>) {
+    constexpr std::size_t count = sizeof...(ParamIndices);
+    constexpr std::size_t unnamed_index = find_first(std::array<bool, count>{keyword_name<typename type_at_t<ParamIndices, Params>::id>::has_name...}, false);
+    if constexpr (unnamed_index != count) {
+        return syntax_error<unnamed_keyword<typename type_at_t<unnamed_index, Params>::id>>();
+    } else {
+        constexpr std::size_t duplicate_index = find_duplicate_name(std::array<std::string_view, count>{keyword_name<typename type_at_t<ParamIndices, Params>::id>::value...});
+        if constexpr (duplicate_index != count) {
+            return syntax_error<duplicate_keyword_name<typename type_at_t<duplicate_index, Params>::id>>();
+        } else {
+            constexpr std::size_t error_index = find_first(std::array<bool, count>{is_error_v<decltype(validate_cli_param<Params, Vals, ParamIndices>())>...}, true);
+            if constexpr (error_index != count) {
+                return validate_cli_param<Params, Vals, error_index>();
+            } else {
+                return nullptr;
+            }
+        }
+    }
+}
+
+template <class ...Params>
+constexpr auto validate_cli_params() {
+    using np_t = decltype(validate_params(type_list<Params...>()));
+    constexpr std::size_t unsupported_index = find_first(std::array<bool, sizeof...(Params)>{is_cli_parameter<Params>::value...}, false);
+    if constexpr (is_error_v<np_t>) {
+        return np_t();
+    } else if constexpr (unsupported_index != sizeof...(Params)) {
+        return syntax_error<unsupported_cli_parameter<typename type_at_t<unsupported_index, type_list<Params...>>::id>>();
+    } else {
+        return validate_cli_params_i<type_list<Params...>, type_list<cli_value_t<Params>...>>(std::index_sequence_for<Params...>());
+    }
+}
+
+/* Binders */
+
+template <class Params, class F, std::size_t ...Indices, class ...Vals>
+FLEXARGS_INLINE void invoke_with_keywords(F &&f, std::index_sequence<Indices...>, Vals &...vals) {
+    std::forward<F>(f)((keyword<typename type_at_t<Indices, Params>::id>() = std::move(vals))...);
+}
+
+// Parses the values of the parameters one by one, and then passes them to 'f' by keywords.
+template <class Params, std::size_t Index, class F, class Refs, std::size_t N, class ...Vals>
+FLEXARGS_INLINE cli_error bind_cli_values(F &&f, Refs &refs, std::array<std::string_view, N> const &args, std::array<bool, N> const &given, Vals &...vals) {
+    if constexpr (Index == N) {
+        invoke_with_keywords<Params>(std::forward<F>(f), std::index_sequence_for<Vals...>(), vals...);
+        return {cli_errc::ok, {}};
+    } else {
+        using param_t = type_at_t<Index, Params>;
+        using val_t = cli_value_t<param_t>;
+        if (given[Index]) {
+            parsed_value<val_t> parsed = parse_cli_value<val_t>(args[Index]);
+            if (!parsed.ok) {
+                return {cli_errc::invalid_value, args[Index]};
+            }
+            return bind_cli_values<Params, Index + 1>(std::forward<F>(f), refs, args, given, vals..., parsed.val);
+        } else if constexpr (param_t::is_default) {
+            val_t val(std::move(get_ref<Index>(refs)).def(vals...));
+            return bind_cli_values<Params, Index + 1>(std::forward<F>(f), refs, args, given, vals..., val);
+        } else {
+            return {cli_errc::missing_argument, keyword_name<typename param_t::id>::value};
+        }
+    }
+}
+
+template <class F, class ...Params>
+cli_error bind_cli_i(char const *const *argv, F &&f, Params &&...params) {
+    using params_t = type_list<std::remove_cv_t<std::remove_reference_t<Params>>...>;
+    using table = cli_keyword_table<typename std::remove_cv_t<std::remove_reference_t<Params>>::id...>;
+    constexpr std::size_t count = sizeof...(Params);
+    constexpr std::array<bool, count> is_keyword = {std::remove_reference_t<Params>::is_keyword...};
+    constexpr std::array<bool, count> is_default = {std::remove_reference_t<Params>::is_default...};
+    constexpr std::array<bool, count> is_flag = {std::is_same_v<cli_value_t<std::remove_cv_t<std::remove_reference_t<Params>>>, bool>...};
+    std::array<std::string_view, count> args = {};
+    std::array<bool, count> given = {};
+    std::size_t position = 0;
+    if (*argv) {
+        ++argv;
+    }
+    for (; *argv; ++argv) {
+        std::string_view arg = *argv;
+        if (arg.size() > 2 && arg.substr(0, 2) == "--") {
+            std::size_t eq = arg.find('=');
+            std::size_t index = table::find(eq == std::string_view::npos ? arg.substr(2) : arg.substr(2, eq - 2));
+            if (index == npos) {
+                return {cli_errc::unknown_keyword, arg};
+            } else if (given[index]) {
+                return {cli_errc::duplicate_argument, arg};
+            } else if (eq != std::string_view::npos) {
+                args[index] = arg.substr(eq + 1);
+            } else if (is_flag[index]) {
+                args[index] = "true";
+            } else if (argv[1]) {
+                args[index] = *++argv;
+            } else {
+                return {cli_errc::missing_value, arg};
+            }
+            given[index] = true;
+        } else {
+            if (position >= count || is_keyword[position]) {
+                return {cli_errc::extra_argument, arg};
+            } else if (given[position]) {
+                return {cli_errc::duplicate_argument, arg};
+            }
+            args[position] = arg;
+            given[position] = true;
+            ++position;
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!given[i] && !is_default[i]) {
+            return {cli_errc::missing_argument, table::names[i]};
+        }
+    }
+    ref_pack<Params...> refs = {{std::forward<Params>(params)}...};
+    return bind_cli_values<params_t, 0>(std::forward<F>(f), refs, args, given);
+}
+
+} // namespace detail
+
+/* Binders */
+
+// Parses command-line arguments 'argv' (as passed to main()) according to 'params', and calls 'f' with all of them by keywords.
+// Each keyword must have a name, i.e. its id must have a static data member 'name'.
+// '--name=value', '--name value' and '--name' (for bool parameters) specify a parameter by its name, and the other arguments specify parameters by positions.
+// Typed parameters are parsed as their types (by std::from_chars for arithmetic types), and the others are passed as std::string_view.
+// Optional and variadic parameters are not supported.
+// Returns a cli_error, or an error type if the parameters are invalid.
+template <class F, class ...Params>
+auto bind_cli(char const *const *argv, F &&f, Params &&...params) {
+    using np_t = decltype(detail::validate_cli_params<std::remove_cv_t<std::remove_reference_t<Params>>...>());
+    if constexpr (detail::is_error_v<np_t>) {
+        return np_t();
+    } else {
+        return detail::bind_cli_i(argv, std::forward<F>(f), std::forward<Params>(params)...);
+    }
+}
+
+} // namespace flexargs
+
+#endif
@@ -0,0 +1,166 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <boost/core/lightweight_test.hpp>
+#include "common.hpp"
+#include "../flexargs_cli.hpp"
+using namespace std::literals;
+using namespace flexargs;
+
+namespace cli_keywords {
+    struct op_ { static constexpr std::string_view name = "op"; };
+    struct lhs_ { static constexpr std::string_view name = "lhs"; };
+    struct rhs_ { static constexpr std::string_view name = "rhs"; };
+    struct verbose_ { static constexpr std::string_view name = "verbose"; };
+    struct label_ { static constexpr std::string_view name = "label"; };
+    struct other_lhs_ { static constexpr std::string_view name = "lhs"; };
+
+    inline constexpr keyword<op_> op;
+    inline constexpr keyword<lhs_> lhs;
+    inline constexpr keyword<rhs_> rhs;
+    inline constexpr keyword<verbose_> verbose;
+    inline constexpr keyword<label_> label;
+    inline constexpr keyword<other_lhs_> other_lhs;
+}
+
+struct calc_result {
+    std::string_view op;
+    int lhs = 0;
+    int rhs = 0;
+    bool verbose = false;
+    std::string label;
+};
+
+template <std::size_t N>
+cli_error calc(char const *(&&argv)[N], calc_result &r) {
+    using namespace cli_keywords;
+    return bind_cli(
+        argv,
+        [&](auto &&...args) {
+            auto [op_, lhs_, rhs_, verbose_, label_] = match(
+                parameter(op),
+                parameter<int>(lhs),
+                parameter<int>(rhs) = 1,
+                keyword_parameter<bool>(verbose) = false,
+                keyword_parameter<std::string>(label) = lazy([](std::string_view op, int, int, bool) { return std::string(op) + "!"; }),
+                std::forward<decltype(args)>(args)...
+            );
+            r = {op_, lhs_, rhs_, verbose_, label_};
+        },
+        parameter(op),
+        parameter<int>(lhs),
+        parameter<int>(rhs) = 1,
+        keyword_parameter<bool>(verbose) = false,
+        keyword_parameter<std::string>(label) = lazy([](std::string_view op, int, int, bool) { return std::string(op) + "!"; })
+    );
+}
+
+int main() {
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", "--lhs=3", "--rhs", "4", nullptr}, r);
+        BOOST_TEST(!e);
+        BOOST_TEST(r.op == "add");
+        BOOST_TEST_EQ(r.lhs, 3);
+        BOOST_TEST_EQ(r.rhs, 4);
+        BOOST_TEST(!r.verbose);
+        BOOST_TEST_EQ(r.label, "add!");
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "--verbose", "--label=x", "sub", "-5", nullptr}, r);
+        BOOST_TEST(!e);
+        BOOST_TEST(r.op == "sub");
+        BOOST_TEST_EQ(r.lhs, -5);
+        BOOST_TEST_EQ(r.rhs, 1);
+        BOOST_TEST(r.verbose);
+        BOOST_TEST_EQ(r.label, "x");
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", "--lhs=1", "--verbose=false", nullptr}, r);
+        BOOST_TEST(!e);
+        BOOST_TEST(!r.verbose);
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", "--lhs=1", "--width=2", nullptr}, r);
+        BOOST_TEST(e.code == cli_errc::unknown_keyword);
+        BOOST_TEST(e.arg == "--width=2");
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", "--lhs", nullptr}, r);
+        BOOST_TEST(e.code == cli_errc::missing_value);
+        BOOST_TEST(e.arg == "--lhs");
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", "--lhs=one", nullptr}, r);
+        BOOST_TEST(e.code == cli_errc::invalid_value);
+        BOOST_TEST(e.arg == "one");
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", "2", "--lhs=1", nullptr}, r);
+        BOOST_TEST(e.code == cli_errc::duplicate_argument);
+        BOOST_TEST(e.arg == "--lhs=1");
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", nullptr}, r);
+        BOOST_TEST(e.code == cli_errc::missing_argument);
+        BOOST_TEST(e.arg == "lhs");
+    }
+    {
+        calc_result r;
+        auto e = calc({"calc", "add", "1", "2", "true", nullptr}, r);
+        BOOST_TEST(e.code == cli_errc::extra_argument);
+        BOOST_TEST(e.arg == "true");
+    }
+    {
+        using namespace cli_keywords;
+        char const *argv[] = {"calc", nullptr};
+        auto e = bind_cli(argv, [](auto &&...) {}, parameter(keywords::x));
+        static_assert(is_instance_of<detail::syntax_error<detail::unnamed_keyword<keywords::x_>>>(e));
+    }
+    {
+        using namespace cli_keywords;
+        char const *argv[] = {"calc", nullptr};
+        auto e = bind_cli(argv, [](auto &&...) {}, parameter(lhs), parameter(other_lhs));
+        static_assert(is_instance_of<detail::syntax_error<detail::duplicate_keyword_name<other_lhs_>>>(e));
+    }
+    {
+        using namespace cli_keywords;
+        char const *argv[] = {"calc", nullptr};
+        auto e = bind_cli(argv, [](auto &&...) {}, parameter<int>(lhs) = "one"s);
+        static_assert(is_instance_of<detail::type_error<detail::not_convertible<std::string, int>>>(e));
+    }
+    {
+        using namespace cli_keywords;
+        char const *argv[] = {"calc", nullptr};
+        auto e = bind_cli(argv, [](auto &&...) {}, parameter<std::is_integral>(lhs));
+        static_assert(is_instance_of<detail::type_error<detail::not_satisfying<std::string_view, std::is_integral>>>(e));
+    }
+    {
+        using namespace cli_keywords;
+        char const *argv[] = {"calc", nullptr};
+        auto e = bind_cli(argv, [](auto &&...) {}, parameter(op), optional_keyword_parameter<int>(lhs));
+        static_assert(is_instance_of<detail::syntax_error<detail::unsupported_cli_parameter<lhs_>>>(e));
+    }
+    {
+        using namespace cli_keywords;
+        char const *argv[] = {"calc", nullptr};
+        auto e = bind_cli(argv, [](auto &&...) {}, parameter(op), var_positional(label));
+        static_assert(is_instance_of<detail::syntax_error<detail::unsupported_cli_parameter<label_>>>(e));
+    }
+    return boost::report_errors();
+}
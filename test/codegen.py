@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+
+# cpp-flexargs
+#
+# Copyright iorate 2018.
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE_1_0.txt or copy at
+# http://www.boost.org/LICENSE_1_0.txt)
+
+# Checks that a call of a function accepting keyword arguments is compiled to
+# the same machine code as the equivalent call of a plain function.
+#
+# For each workload, a translation unit defines a plain function (<name>_v0)
+# and the same function accepting keyword arguments (<name>_v1), and a pair of
+# wrappers for every call: one calling <name>_v0 with the arguments in order
+# and the other calling <name>_v1 with them in some order, passed by position
+# or by keyword, with some defaults omitted. The TU is compiled to assembly,
+# and each keyword wrapper fails if it has more instructions, calls or stack
+# accesses than its plain counterpart.
+
+import argparse
+import itertools
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+class Workload:
+    def __init__(self, name, result, params, body):
+        # params is a list of (name, type, default or None).
+        self.name = name
+        self.result = result
+        self.params = params
+        self.body = body
+
+    def definitions(self):
+        v0_params = ', '.join('{} {}{}'.format(t, n, '' if d is None else ' = ' + d) for n, t, d in self.params)
+        v1_params = ''.join('        flexargs::parameter<{}>(kw::{}){},\n'.format(t, n, '' if d is None else ' = ' + d) for n, t, d in self.params)
+        names = ', '.join(n for n, _, _ in self.params)
+        return '''inline {result} {name}_v0({v0_params}) {{
+    {body}
+}}
+
+template <class ...Args>
+inline {result} {name}_v1(Args &&...args) {{
+    auto [{names}] = flexargs::match(
+{v1_params}        std::forward<Args>(args)...
+    );
+    {body}
+}}
+'''.format(result=self.result, name=self.name, v0_params=v0_params, v1_params=v1_params, names=names, body=self.body)
+
+    def calls(self):
+        # Yields the passed parameters in the order of the call and how many of
+        # them are passed by position.
+        required = [n for n, _, d in self.params if d is None]
+        optional = [n for n, _, d in self.params if d is not None]
+        for count in range(len(optional) + 1):
+            for omitted in itertools.combinations(optional, len(optional) - count):
+                passed = [n for n, _, _ in self.params if n not in omitted]
+                for positional in range(len(required) + 1):
+                    for rest in itertools.permutations(passed[positional:]):
+                        yield passed[:positional] + list(rest), positional
+
+    def wrappers(self, index, passed, positional):
+        wrapper_params = ', '.join('{} {}'.format(t, n) for n, t, _ in self.params if n in passed)
+        v0_args = ', '.join(n if n in passed else d for n, _, d in self.params)
+        v1_args = ', '.join(n if i < positional else 'kw::{0} = {0}'.format(n) for i, n in enumerate(passed))
+        return '''extern "C" {result} plain_{index}({wrapper_params}) {{
+    return {name}_v0({v0_args});
+}}
+
+extern "C" {result} flexargs_{index}({wrapper_params}) {{
+    return {name}_v1({v1_args});
+}}
+'''.format(result=self.result, index=index, wrapper_params=wrapper_params, name=self.name, v0_args=v0_args, v1_args=v1_args)
+
+
+WORKLOADS = [
+    Workload('calc', 'int', [
+        ('a', 'int', None),
+        ('b', 'int', None),
+        ('c', 'int', '1'),
+        ('d', 'int', '2'),
+    ], 'return a * b + c - d;'),
+    Workload('label', 'std::size_t', [
+        ('text', 'std::string_view', None),
+        ('width', 'std::size_t', '8'),
+        ('fill', 'char', "' '"),
+    ], "return text.size() < width ? width * (fill == ' ' ? 1 : 2) : text.size();"),
+    Workload('scale', 'void', [
+        ('out', 'double &', None),
+        ('x', 'double const &', None),
+        ('factor', 'double', '2.0'),
+    ], 'out = x * factor;'),
+]
+
+
+def generate(workload):
+    keywords = ''.join('    inline constexpr flexargs::keyword<struct {0}_> {0};\n'.format(n) for n, _, _ in workload.params)
+    cases = []
+    wrappers = []
+    for index, (passed, positional) in enumerate(workload.calls()):
+        cases.append((index, passed, positional))
+        wrappers.append(workload.wrappers(index, passed, positional))
+    source = '''#include <cstddef>
+#include <string_view>
+#include <utility>
+#include "flexargs.hpp"
+
+namespace kw {{
+{keywords}}}
+
+{definitions}
+{wrappers}'''.format(keywords=keywords, definitions=workload.definitions(), wrappers='\n'.join(wrappers))
+    return source, cases
+
+
+CALL = re.compile(r'^(call|bl|blr|jmp\s+[A-Za-z_]|b\s+[A-Za-z_])')
+STACK = re.compile(r'%[re]sp|%[re]bp|\bsp\b|\bx29\b|^push|^pop')
+
+
+def functions(asm):
+    # Maps each function name to its instructions, without labels, directives
+    # and comments.
+    result = {}
+    current = None
+    for line in asm.splitlines():
+        line = line.split('#')[0].split('//')[0].rstrip()
+        label = re.match(r'^([A-Za-z_][\w.$]*):', line)
+        if label:
+            if label.group(1).startswith(('plain_', 'flexargs_')):
+                current = label.group(1)
+                result[current] = []
+            continue
+        stripped = line.strip()
+        if current is None or not stripped or stripped.endswith(':'):
+            continue
+        if stripped.startswith('.'):
+            if stripped.startswith(('.cfi_endproc', '.size')):
+                current = None
+            continue
+        result[current].append(re.sub(r'\s+', ' ', stripped))
+    return result
+
+
+def metrics(instructions):
+    return {
+        'instructions': len(instructions),
+        'calls': sum(1 for i in instructions if CALL.match(i)),
+        'stack': sum(1 for i in instructions if STACK.search(i)),
+    }
+
+
+def check(compiler, std, opt, flags, workload, verbose):
+    source, cases = generate(workload)
+    workdir = tempfile.mkdtemp(prefix='flexargs-codegen-')
+    try:
+        path = os.path.join(workdir, workload.name + '.cpp')
+        with open(path, 'w') as f:
+            f.write(source)
+        cmd = [compiler, '-std=' + std, '-' + opt, '-I', ROOT, '-S', '-o', '-', path] + flags
+        if 'clang' not in os.path.basename(compiler):
+            # Otherwise a plain wrapper may be folded into an identical one and compiled to a jump.
+            cmd.append('-fno-ipa-icf')
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+        if proc.returncode != 0:
+            print('{} -{} {}: compilation failed\n{}'.format(compiler, opt, workload.name, proc.stderr), file=sys.stderr)
+            return 1
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+    funcs = functions(proc.stdout)
+    failures = 0
+    for index, passed, positional in cases:
+        if 'plain_{}'.format(index) not in funcs or 'flexargs_{}'.format(index) not in funcs:
+            print('{} -{} {}: wrappers not found in the assembly'.format(compiler, opt, workload.name), file=sys.stderr)
+            return 1
+        plain = funcs['plain_{}'.format(index)]
+        keyword = funcs['flexargs_{}'.format(index)]
+        plain_metrics = metrics(plain)
+        keyword_metrics = metrics(keyword)
+        worse = [k for k in plain_metrics if keyword_metrics[k] > plain_metrics[k]]
+        call = '{}_v1({})'.format(workload.name, ', '.join(n if i < positional else n + ' = ...' for i, n in enumerate(passed)))
+        if worse:
+            failures += 1
+            print('FAIL {} -{} {}: more {} than the plain call'.format(compiler, opt, call, ', '.join(worse)))
+            print('  plain:    ' + '; '.join(plain))
+            print('  flexargs: ' + '; '.join(keyword))
+        elif verbose:
+            print('ok   {} -{} {}: {}'.format(compiler, opt, call, keyword_metrics))
+    print('{} -{} {}: {} of {} calls match the plain code'.format(compiler, opt, workload.name, len(cases) - failures, len(cases)))
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Codegen equivalence of keyword calls and plain calls.')
+    parser.add_argument('--compilers', nargs='+', default=['g++', 'clang++'])
+    parser.add_argument('--opts', nargs='+', default=['O2'])
+    parser.add_argument('--std', default='c++17')
+    parser.add_argument('--cxxflags', default='', help='extra compiler flags')
+    parser.add_argument('--verbose', action='store_true')
+    opts = parser.parse_args()
+
+    failures = 0
+    found = False
+    for compiler in opts.compilers:
+        if shutil.which(compiler) is None:
+            print('{} not found; skipped'.format(compiler), file=sys.stderr)
+            continue
+        found = True
+        for opt in opts.opts:
+            for workload in WORKLOADS:
+                failures += check(compiler, opts.std, opt, opts.cxxflags.split(), workload, opts.verbose)
+    if not found:
+        print('no compiler found', file=sys.stderr)
+        return 1
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
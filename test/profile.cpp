@@ -0,0 +1,66 @@
+
+// cpp-flexargs
+//
+// Copyright iorate 2018.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define FLEXARGS_PROFILE
+// The third plan overflows, and is counted under a lock.
+#define FLEXARGS_PROFILE_MAX_PLANS 2
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include "common.hpp"
+using namespace flexargs;
+
+template <class ...Args>
+constexpr int f(Args &&...args) {
+    auto [x, y] = match(
+        parameter<int>(keywords::x),
+        parameter<int>(keywords::y) = 2,
+        std::forward<Args>(args)...
+    );
+    return x + y;
+}
+
+static_assert(f(1) == 3);
+
+int main() {
+    using namespace keywords;
+    BOOST_TEST(profile_records().empty());
+
+    f(1);
+    f(1, 2);
+    std::thread([] {
+        f(1);
+        f(y = 2, x = 1);
+    }).join();
+
+    auto records = profile_records();
+    BOOST_TEST_EQ(records.size(), 3u);
+    BOOST_TEST((records[0].parameters == std::vector<std::string>{"keywords::x_", "keywords::y_"}));
+    BOOST_TEST((records[0].arguments == std::vector<std::string>{""}));
+    BOOST_TEST((records[0].defaults == std::vector<bool>{false, true}));
+    BOOST_TEST_EQ(records[0].calls, 2u);
+    BOOST_TEST((records[1].defaults == std::vector<bool>{false, false}));
+    BOOST_TEST_EQ(records[1].calls, 1u);
+    BOOST_TEST((records[2].arguments == std::vector<std::string>{"keywords::y_", "keywords::x_"}));
+    BOOST_TEST_EQ(records[2].calls, 1u);
+    BOOST_TEST(!records[1].overflowed);
+    BOOST_TEST(records[2].overflowed);
+
+    std::ostringstream os;
+    write_profile_json(os);
+    BOOST_TEST(os.str().find(R"({"parameters": ["keywords::x_", "keywords::y_"], "arguments": [null], "defaults": [false, true], "calls": 2})") != std::string::npos);
+    BOOST_TEST(os.str().find(R"("defaults": [false, false], "calls": 1, "overflowed": true})") != std::string::npos);
+
+    std::ostringstream escaped;
+    detail::write_json_string(escaped, "a\"b\\c\n");
+    BOOST_TEST_EQ(escaped.str(), R"("a\"b\\c\u000a")");
+
+    return boost::report_errors();
+}
@@ -7,6 +7,8 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 
 #include "common.hpp"
+#include <functional>
+#include <tuple>
 #include <vector>
 #include <boost/core/lightweight_test.hpp>
 using namespace std::literals;
@@ -38,6 +40,209 @@ void g(Args &&...args) {
     BOOST_TEST((y == std::vector{"c"s, "d"s}));
 }
 
+template <class ...Args>
+void assign(Args &&...args) {
+    auto [x, y] = match(
+        parameter(keywords::x),
+        parameter(keywords::y),
+        std::forward<Args>(args)...
+    );
+    x = y;
+}
+
+int lazy_count = 0;
+
+template <class ...Args>
+auto h(Args &&...args) {
+    auto [x, y, z] = match(
+        parameter<int>(keywords::x),
+        parameter<std::string>(keywords::y) = lazy([] { ++lazy_count; return "y"s; }),
+        parameter<int>(keywords::z) = lazy([](int x, std::string const &y) { return x + static_cast<int>(y.size()); }),
+        std::forward<Args>(args)...
+    );
+    return std::make_tuple(x, y, z);
+}
+
+// The extra arguments are counted, and the unknown keyword arguments are passed to h().
+template <class ...Args>
+auto v(Args &&...args) {
+    auto [x, rest, options] = match(
+        parameter<int>(keywords::x),
+        var_positional(keywords::y),
+        var_keyword(keywords::z),
+        std::forward<Args>(args)...
+    );
+    std::size_t count = std::move(rest).apply([](auto &&...rest) { return sizeof...(rest); });
+    return std::make_tuple(count, std::move(options).apply([&](auto &&...options) { return h(x, std::forward<decltype(options)>(options)...); }));
+}
+
+// x is matched here, and only y and z among the other keyword arguments are passed to h(), so each argument is forwarded once.
+template <class ...Args>
+auto layered(Args &&...args) {
+    auto [x, options] = match(
+        parameter<int>(keywords::x),
+        var_keyword(keywords::w),
+        std::forward<Args>(args)...
+    );
+    return std::move(options).apply([&](auto &&...options) {
+        return forward_keywords<keywords::y, keywords::z>(std::forward<decltype(options)>(options)...).apply([&](auto &&...args) {
+            return h(x + 1, std::forward<decltype(args)>(args)...);
+        });
+    });
+}
+
+template <class ...Args>
+std::string *address_of_y(Args &&...args) {
+    auto [y] = match(parameter(keywords::y), std::forward<Args>(args)...);
+    return &y;
+}
+
+struct counted {
+    static inline int moves = 0;
+    int val;
+    counted(int val) : val(val) {}
+    counted(counted &&other) : val(other.val) { ++moves; }
+};
+
+struct options {
+    int x;
+    counted y;
+    std::string z;
+};
+
+template <class ...Args>
+options make_options(Args &&...args) {
+    return match_into<options>(
+        parameter<int>(keywords::x),
+        parameter<counted>(keywords::y) = 2,
+        parameter<std::string>(keywords::z) = "z",
+        std::forward<Args>(args)...
+    );
+}
+
+struct pinned {
+    int a;
+    int b;
+    pinned(int a, int b) : a(a), b(b) {}
+    pinned(pinned &&) = delete;
+};
+
+template <class ...Args>
+int sum_pinned(Args &&...args) {
+    auto [x, y] = match(
+        parameter<pinned>(keywords::x),
+        parameter<pinned>(keywords::y) = emplace(3, 4),
+        std::forward<Args>(args)...
+    );
+    return x.a + x.b + y.a + y.b;
+}
+
+template <class ...Args>
+constexpr int tile(Args &&...args) {
+    auto [x, y, z] = match(
+        parameter<int>(keywords::x),
+        keyword_parameter<int>(keywords::y) = constant<4>,
+        keyword_parameter(keywords::z) = constant<true>,
+        std::forward<Args>(args)...
+    );
+    static_assert(std::is_same_v<decltype(z), std::remove_cv_t<std::remove_reference_t<decltype(z)>>>);
+    if constexpr (is_constant_v<decltype(y)> && decltype(z)::value) {
+        static_assert(std::is_same_v<decltype(y), std::integral_constant<int, decltype(y)::value>>);
+        return x * decltype(y)::value;
+    } else {
+        return x + y;
+    }
+}
+
+template <class ...Args>
+constexpr int hooked(Args &&...args) {
+    auto [x, scale, on_x] = match(
+        parameter<int>(keywords::x),
+        optional_parameter<int>(keywords::z),
+        optional_keyword_parameter(keywords::y),
+        std::forward<Args>(args)...
+    );
+    int r = x;
+    if constexpr (!is_absent_v<decltype(on_x)>) {
+        r = on_x(r);
+    }
+    if constexpr (!is_absent_v<decltype(scale)>) {
+        r *= scale;
+    }
+    return r;
+}
+
+template <class ...Args>
+auto make_task(Args &&...args) {
+    return capture(
+        parameter<char>(keywords::x),
+        parameter(keywords::y),
+        parameter(keywords::z) = 'z',
+        keyword_parameter(keywords::w) = lazy([](char x, auto &&y, char) { return static_cast<int>(x) + y.val; }),
+        std::forward<Args>(args)...
+    );
+}
+
+enum class mode { copy, add, mul };
+
+template <>
+struct flexargs::enum_size<mode> : std::integral_constant<std::size_t, 3> {};
+
+// Returns the width, negated if it is not a compile-time constant, combined with the mode.
+template <class ...Args>
+constexpr int unrolled(Args &&...args) {
+    auto [x, y] = match(
+        parameter<int>(keywords::x),
+        keyword_parameter<mode>(keywords::y) = mode::copy,
+        std::forward<Args>(args)...
+    );
+    int r = is_constant_v<decltype(x)> ? x : -x;
+    if constexpr (is_constant_v<decltype(y)>) {
+        r += 100 * static_cast<int>(decltype(y)::value);
+    }
+    return r;
+}
+
+inline constexpr auto call_unrolled = [](auto &&...args) { return unrolled(std::forward<decltype(args)>(args)...); };
+
+template <class ...Args>
+void axpy(Args &&...args) {
+    auto [x, z, y] = match(
+        parameter<int>(keywords::x),
+        parameter(keywords::z),
+        parameter<int>(keywords::y) = 0,
+        std::forward<Args>(args)...
+    );
+    z = 2 * x + y;
+}
+
+template <class ...Args>
+std::size_t axpy_columns(Args &&...args) {
+    auto [x, y, z] = match(
+        parameter<column_view<int const>>(keywords::x),
+        parameter<int>(keywords::y),
+        parameter<column_view<int>>(keywords::z),
+        std::forward<Args>(args)...
+    );
+    for (std::size_t i = 0; i < z.size; ++i) {
+        z.data[i] = 2 * x.data[i] + y;
+    }
+    return z.size;
+}
+
+inline const auto sig = signature(
+    parameter<int>(keywords::x),
+    parameter(keywords::y) = "y"s,
+    parameter<std::size_t>(keywords::z) = lazy([](int, std::string const &y) { return y.size(); })
+);
+
+template <class ...Args, class = decltype(match_(sig, std::declval<Args>()...))>
+auto s(Args &&...args) {
+    auto [x, y, z] = match(sig, std::forward<Args>(args)...);
+    static_assert(std::is_same_v<decltype(match(sig, std::forward<Args>(args)...)), match_result_t<decltype(sig), Args...>>);
+    return std::make_tuple(x, y, z);
+}
+
 int main() {
     using namespace keywords;
 
@@ -48,5 +253,135 @@ int main() {
 
     g(x = {"a"s, "b"s}, y = {"c"s, "d"s});
 
+    static_assert(std::is_same_v<decltype((x = 1).val()), int &&>);
+    static_assert(std::is_same_v<decltype(std::declval<decltype(x = 1) const>().val()), int>);
+    static_assert(std::is_same_v<decltype(std::declval<decltype(x = "a"s) const>().val()), std::string &&>);
+    static_assert(std::is_same_v<decltype(std::declval<detail::argument<std::string> const>().val()), std::string &&>);
+    int i = 0;
+    assign(x = i, y = 42);
+    BOOST_TEST_EQ(i, 42);
+
+    BOOST_TEST((h(1) == std::make_tuple(1, "y"s, 2)));
+    BOOST_TEST_EQ(lazy_count, 1);
+    BOOST_TEST((h(1, "abc"s) == std::make_tuple(1, "abc"s, 4)));
+    BOOST_TEST((h(z = 5, x = 1) == std::make_tuple(1, "y"s, 5)));
+    BOOST_TEST_EQ(lazy_count, 2);
+
+    BOOST_TEST((s(1) == std::make_tuple(1, "y"s, std::size_t(1))));
+    BOOST_TEST((s(z = 5, y = "abc"s, x = 2) == std::make_tuple(2, "abc"s, std::size_t(5))));
+    BOOST_TEST((s(3, "abcd"s) == std::make_tuple(3, "abcd"s, std::size_t(4))));
+    BOOST_TEST((std::get<1>(sig._params)._def == "y"s));
+
+    auto r = match(parameter(x), parameter<std::string>(y) = "y"s, 1);
+    static_assert(std::tuple_size_v<decltype(r)> == 2);
+    static_assert(std::is_same_v<std::tuple_element_t<0, decltype(r)>, int &&>);
+    static_assert(std::is_same_v<std::tuple_element_t<1, decltype(r)>, std::string>);
+    static_assert(std::is_same_v<decltype(get<1>(r)), std::string &>);
+    static_assert(std::is_same_v<decltype(get<0>(std::move(r))), int &&>);
+    BOOST_TEST_EQ(get<1>(r), "y");
+
+    BOOST_TEST((v(1) == std::make_tuple(std::size_t(0), std::make_tuple(1, "y"s, 2))));
+    BOOST_TEST((v(1, 2, 3, z = 5) == std::make_tuple(std::size_t(2), std::make_tuple(1, "y"s, 5))));
+    BOOST_TEST((v(y = "abc"s, x = 1) == std::make_tuple(std::size_t(0), std::make_tuple(1, "abc"s, 4))));
+
+    std::string str = "str";
+    auto [_, rest] = match(parameter(x), var_positional(y), 1, str, "lit"s);
+    static_assert(std::is_same_v<decltype(rest), detail::var_args<std::string &, std::string>>);
+    BOOST_TEST(std::move(rest).apply([&](std::string &s1, std::string &&) { return &s1 == &str; }));
+
+    BOOST_TEST((layered(x = 1) == std::make_tuple(2, "y"s, 3)));
+    BOOST_TEST((layered(z = 5, y = "abc"s, x = 1) == std::make_tuple(2, "abc"s, 5)));
+    BOOST_TEST(forward_keywords<y>(1, x = 2, y = std::move(str)).apply([](auto &&...args) { return address_of_y(std::forward<decltype(args)>(args)...); }) == &str);
+    static_assert(std::is_same_v<decltype(forward_keywords<y>(1, x = 2)), detail::var_args<>>);
+
+    options o = make_options(1, z = "abc");
+    BOOST_TEST_EQ(o.x, 1);
+    BOOST_TEST_EQ(o.y.val, 2);
+    BOOST_TEST_EQ(o.z, "abc");
+    BOOST_TEST_EQ(counted::moves, 0);
+    struct sig_options {
+        int x;
+        std::string y;
+        std::size_t z;
+    } so = match_into<sig_options>(sig, 4, z = 5);
+    BOOST_TEST((std::make_tuple(so.x, so.y, so.z) == std::make_tuple(4, "y"s, std::size_t(5))));
+
+    BOOST_TEST_EQ(sum_pinned(emplace(1, 2)), 10);
+    BOOST_TEST_EQ(sum_pinned(y = emplace(5, 6), x = emplace(1, 2)), 14);
+    int n = 0;
+    auto [e] = match(parameter<std::vector<int>>(x), x = emplace(std::size_t(3), n));
+    BOOST_TEST((e == std::vector<int>{0, 0, 0}));
+
+    static_assert(get<1>(match(parameter<int>(x), parameter<int>(y) = lazy([](int x) { return x * 2; }), 3)) == 6);
+
+    static_assert(tile(2) == 8);
+    static_assert(tile(2, y = constant<8L>) == 16);
+    static_assert(tile(2, y = 8) == 10);
+    static_assert(tile(2, z = constant<false>) == 6);
+
+    static_assert(hooked(2) == 2);
+    static_assert(hooked(2, 3) == 6);
+    static_assert(hooked(2, y = [](int i) { return i + 1; }) == 3);
+    static_assert(hooked(z = 4, y = [](int i) { return i + 1; }, x = 2) == 12);
+    static_assert(std::is_same_v<decltype(match(optional_parameter(x))), detail::result<absent_t>>);
+
+    {
+        int moves = counted::moves;
+        int out = 0;
+        auto task = capture(parameter(x), parameter(y), parameter(w), parameter(z) = 'c', 'a', counted(1), std::ref(out));
+        BOOST_TEST_EQ(counted::moves - moves, 1);
+        struct unsorted { char a; counted b; std::reference_wrapper<int> d; char c; };
+        struct sorted { std::reference_wrapper<int> d; counted b; char a; char c; };
+        static_assert(sizeof(task) == sizeof(sorted) && sizeof(task) < sizeof(unsorted));
+        std::move(task).apply([](char a, counted &&b, int &d, char c) { d = a + b.val + c; });
+        BOOST_TEST_EQ(out, 'a' + 1 + 'c');
+
+        std::string str = "str";
+        auto copied = capture(parameter(x), str);
+        str.clear();
+        BOOST_TEST_EQ(copied.apply([](std::string const &s) { return s; }), "str");
+        static_assert(std::is_same_v<decltype(capture(parameter<std::is_integral>(x), 1)), detail::capture<int &&>>);
+
+        char buf[] = "buf";
+        auto typed = capture(parameter<std::string>(x), buf);
+        buf[0] = '\0';
+        BOOST_TEST_EQ(typed.apply([](std::string const &s) { return s; }), "buf");
+
+        std::string order;
+        auto ordered = capture(
+            parameter<char>(x) = lazy([&] { order += 'x'; return 'x'; }),
+            parameter<double>(y) = lazy([&] { order += 'y'; return 1.0; })
+        );
+        BOOST_TEST_EQ(order, "xy");
+        BOOST_TEST_EQ(ordered.apply([](char c, double d) { return c + d; }), 'x' + 1.0);
+
+        moves = counted::moves;
+        auto lazy_task = make_task('a', y = counted(2));
+        BOOST_TEST_EQ(counted::moves - moves, 1);
+        BOOST_TEST_EQ(std::move(lazy_task).apply([](char a, counted &&b, char c, int d) { return a + b.val + c + d; }), 'a' + 2 + 'z' + 'a' + 2);
+    }
+
+    static_assert(dispatch_invoke(call_unrolled, among<4, 8, 16>(8)) == 8);
+    static_assert(dispatch_invoke(call_unrolled, among<4, 8, 16>(5)) == -5);
+    static_assert(dispatch_invoke(call_unrolled, x = among<1, 2, 3>(3)) == 3);
+    static_assert(dispatch_invoke(call_unrolled, y = among_enum<mode>(mode::mul), x = among<4L, 8L>(4L)) == 204);
+    static_assert(dispatch_invoke(call_unrolled, 2, y = among_enum<mode, 2>(mode::mul)) == -2);
+    static_assert(std::is_same_v<decltype(among_enum<mode>(mode::add)), detail::among_value<mode, mode::copy, mode::add, mode::mul>>);
+    static_assert(detail::among_index(among<-1, 0, 1>(0)) == 1);
+    static_assert(detail::among_index(among<10, 20, 30>(20)) == 1);
+    static_assert(detail::among_index(among<10, 20, 30>(25)) == 3);
+    static_assert(detail::among_index(among<false, true>(true)) == 1);
+    BOOST_TEST_EQ(dispatch_invoke(call_unrolled, x = among<4, 8, 16>(static_cast<int>(e.size()) * 4 + 4)), 16);
+
+    std::vector<int> const xs = {1, 2, 3};
+    std::vector<int> ys = {10, 20, 30, 40};
+    std::vector<int> zs(3);
+    BOOST_TEST_EQ(batch_invoke([](auto &&...args) { axpy(std::forward<decltype(args)>(args)...); }, z = column(zs), x = column(xs), y = column(ys)), 3u);
+    BOOST_TEST((zs == std::vector<int>{12, 24, 36}));
+    BOOST_TEST_EQ(batch_invoke([](auto &&...args) { axpy(std::forward<decltype(args)>(args)...); }, column(xs), z = column(zs)), 3u);
+    BOOST_TEST((zs == std::vector<int>{2, 4, 6}));
+    BOOST_TEST_EQ(batch_invoke(by_columns, [](auto &&...args) { return axpy_columns(std::forward<decltype(args)>(args)...); }, column(xs), y = 1, z = column(ys)), 3u);
+    BOOST_TEST((ys == std::vector<int>{3, 5, 7, 40}));
+
     return boost::report_errors();
 }
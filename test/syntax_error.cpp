@@ -31,6 +31,16 @@ int main() {
         );
         static_assert(is_instance_of<detail::syntax_error<detail::duplicate_parameter<keywords::x_>>>(e));
     }
+    {
+        auto e = match(
+            parameter(keywords::x),
+            parameter(keywords::y),
+            parameter(keywords::z),
+            parameter(keywords::y),
+            parameter(keywords::x)
+        );
+        static_assert(is_instance_of<detail::syntax_error<detail::duplicate_parameter<keywords::x_>>>(e));
+    }
     {
         auto e = match(
             keyword_parameter<std::is_integral>(keywords::x),
@@ -48,6 +58,17 @@ int main() {
         );
         static_assert(is_instance_of<detail::syntax_error<detail::duplicate_argument<keywords::x_>>>(e));
     }
+    {
+        auto e = match(
+            keyword_parameter<int>(keywords::x) = 7,
+            keyword_parameter<int>(keywords::y) = 7,
+            8,
+            keywords::y = 9,
+            keywords::x = 10,
+            keywords::y = 11
+        );
+        static_assert(is_instance_of<detail::syntax_error<detail::duplicate_argument<keywords::y_>>>(e));
+    }
     {
         auto e = match(
             parameter<int>(keywords::x) = 7,
@@ -62,6 +83,42 @@ int main() {
         );
         static_assert(is_instance_of<detail::syntax_error<detail::missing_argument<keywords::x_>>>(e));
     }
+    {
+        auto e = match(
+            var_positional(keywords::x),
+            parameter(keywords::y) = 10
+        );
+        static_assert(is_instance_of<detail::syntax_error<detail::non_keyword_parameter_after_var_positional_parameter<keywords::y_>>>(e));
+    }
+    {
+        auto e = match(
+            var_keyword(keywords::x),
+            keyword_parameter(keywords::y) = 11
+        );
+        static_assert(is_instance_of<detail::syntax_error<detail::parameter_after_var_keyword_parameter<keywords::y_>>>(e));
+    }
+    {
+        auto e = match(
+            keyword_parameter(keywords::x) = 12,
+            var_positional(keywords::y)
+        );
+        static_assert(is_instance_of<detail::syntax_error<detail::non_keyword_parameter_after_keyword_parameter<keywords::y_>>>(e));
+    }
+    {
+        auto e = match(
+            var_positional(keywords::x),
+            keywords::y = 13,
+            14
+        );
+        static_assert(is_instance_of<detail::syntax_error<detail::non_keyword_argument_after_keyword_argument>>(e));
+    }
+    {
+        auto e = match(
+            var_positional(keywords::x),
+            keywords::y = 13
+        );
+        static_assert(is_instance_of<detail::syntax_error<detail::extra_keyword_argument<keywords::y_>>>(e));
+    }
     {
         auto e = match(
             15
@@ -15,7 +15,17 @@ struct nonmovable {
     nonmovable(nonmovable &&) = delete;
 };
 
+struct takes_string {
+    int operator()(std::string const &) const;
+};
+
 int main() {
+    {
+        constexpr auto sig = signature(parameter<int>(keywords::x));
+        auto e = match(sig, "world"s);
+        static_assert(is_instance_of<detail::type_error<detail::not_convertible<std::string, int>>>(e));
+        static_assert(std::is_same_v<match_result_t<decltype(sig), std::string>, decltype(e)>);
+    }
     {
         auto e = match(
             parameter<int>(keywords::x),
@@ -72,6 +82,30 @@ int main() {
         );
         static_assert(is_instance_of<detail::type_error<detail::not_satisfying<std::string, std::is_integral>>>(e));
     }
+    {
+        auto e = match(
+            parameter<int>(keywords::x),
+            1,
+            keywords::x = "world"s,
+            keywords::y = 2
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_convertible<std::string, int>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<int>(keywords::x) = lazy([] { return "world"s; })
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_convertible<std::string, int>>>(e));
+    }
+    {
+        auto f = [](std::string const &) { return 1; };
+        auto e = match(
+            parameter<int>(keywords::x),
+            parameter(keywords::y) = lazy(f),
+            2
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_invocable<decltype(f) &, int &>>>(e));
+    }
     {
         auto e = match(
             parameter(keywords::x) = nonmovable()
@@ -84,4 +118,61 @@ int main() {
         );
         static_assert(is_instance_of<detail::type_error<detail::not_satisfying<nonmovable, std::is_integral>>>(e));
     }
+    {
+        auto e = match(
+            parameter<int>(keywords::x),
+            parameter(keywords::y) = lazy(takes_string()),
+            parameter(keywords::z) = lazy([](int, int) { return 0; }),
+            1
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_invocable<takes_string, int &>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<char>(keywords::x),
+            keywords::x = constant<300>
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_convertible<std::integral_constant<int, 300> const &, char>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<unsigned>(keywords::x),
+            keywords::x = constant<-1>
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_convertible<std::integral_constant<int, -1> const &, unsigned>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<int>(keywords::x),
+            keywords::x = constant<4000000000u>
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_convertible<std::integral_constant<unsigned, 4000000000u> const &, int>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<int>(keywords::x),
+            keywords::x = among<1, 2>(1)
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_dispatched<detail::among_value<int, 1, 2>>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<nonmovable>(keywords::x),
+            keywords::x = emplace(1)
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_constructible<nonmovable, int>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<std::string>(keywords::x) = emplace(1, 2, 3)
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_constructible<std::string, int, int, int>>>(e));
+    }
+    {
+        auto e = match(
+            parameter<int const &>(keywords::x),
+            keywords::x = emplace(5)
+        );
+        static_assert(is_instance_of<detail::type_error<detail::not_constructible<int const &, int>>>(e));
+    }
 }